@@ -5,6 +5,7 @@
 #include "atom/browser/api/atom_api_app.h"
 
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,6 +16,7 @@
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/atom_browser_main_parts.h"
 #include "atom/browser/browser.h"
+#include "atom/browser/extensions/tab_helper.h"
 #include "atom/browser/login_handler.h"
 #include "atom/browser/net/atom_network_delegate.h"
 #include "atom/browser/relauncher.h"
@@ -74,6 +76,15 @@
 
 using content::CertificateRequestResultType;
 
+namespace {
+
+memory::GuestTabManager* GetGuestTabManager() {
+  return static_cast<memory::GuestTabManager*>(
+      g_browser_process->GetTabManager());
+}
+
+}  // namespace
+
 namespace mate {
 
 #if defined(OS_WIN)
@@ -482,6 +493,8 @@ App::App(v8::Isolate* isolate) {
   content::GpuDataManager::GetInstance()->AddObserver(this);
   Init(isolate);
   static_cast<BrowserProcessImpl*>(g_browser_process)->set_app(this);
+  if (GetGuestTabManager())
+    GetGuestTabManager()->AddObserver(this);
 #if BUILDFLAG(ENABLE_EXTENSIONS)
   registrar_.Add(this,
                  content::NOTIFICATION_WEB_CONTENTS_RENDER_VIEW_HOST_CREATED,
@@ -527,6 +540,8 @@ App::~App() {
   atom::Browser::Get()->RemoveObserver(this);
   net::NetworkChangeNotifier::RemoveMaxBandwidthObserver(this);
   content::GpuDataManager::GetInstance()->RemoveObserver(this);
+  if (g_browser_process && GetGuestTabManager())
+    GetGuestTabManager()->RemoveObserver(this);
 }
 
 void App::OnBeforeQuit(bool* prevent_default) {
@@ -794,6 +809,134 @@ void App::SendMemoryPressureAlert() {
       base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
 }
 
+void App::GetProcessMetrics(
+    const base::Callback<void(v8::Local<v8::Value>)>& callback) {
+  scoped_refptr<ProcessMetricsCollector> collector(
+      new ProcessMetricsCollector(
+          base::Bind(&App::OnProcessMetricsCollected,
+                     base::Unretained(this), callback)));
+  collector->Start(isolate());
+}
+
+void App::OnProcessMetricsCollected(
+    const base::Callback<void(v8::Local<v8::Value>)>& callback,
+    const ProcessMetricsCollector* collector) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+
+  std::set<base::ProcessId> pids;
+  std::vector<mate::Dictionary> processes;
+  for (const auto& info : collector->processes()) {
+    ProcessMetricsCache::Entry* entry = process_metrics_cache_.Get(info.pid);
+    if (!entry)
+      continue;
+    pids.insert(info.pid);
+
+    mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate());
+    dict.Set("pid", static_cast<int>(info.pid));
+    dict.Set("type", info.type);
+    if (!info.name.empty())
+      dict.Set("name", info.name);
+    dict.Set("cpu", entry->metrics->GetCPUUsage());
+    dict.Set("workingSetSize",
+             static_cast<double>(entry->metrics->GetWorkingSetSize() >> 10));
+    size_t private_bytes, shared_bytes;
+    if (entry->metrics->GetMemoryBytes(&private_bytes, &shared_bytes)) {
+      dict.Set("privateBytes", static_cast<double>(private_bytes >> 10));
+      dict.Set("sharedBytes", static_cast<double>(shared_bytes >> 10));
+    }
+#if defined(OS_WIN)
+    DWORD handle_count;
+    if (::GetProcessHandleCount(entry->process.Handle(), &handle_count))
+      dict.Set("openHandles", static_cast<int>(handle_count));
+#elif defined(OS_POSIX)
+    int fd_count = entry->metrics->GetOpenFdCount();
+    if (fd_count >= 0)
+      dict.Set("openHandles", fd_count);
+#endif
+    if (info.type == "renderer") {
+      dict.Set("webContents", std::vector<int32_t>(
+          info.web_contents_ids.begin(), info.web_contents_ids.end()));
+      dict.Set("tabs", std::vector<int32_t>(
+          info.tab_ids.begin(), info.tab_ids.end()));
+    } else if (info.type == "browser") {
+      std::vector<mate::Dictionary> isolates;
+      for (const auto& isolate_info : collector->isolates()) {
+        mate::Dictionary heap = mate::Dictionary::CreateEmpty(isolate());
+        heap.Set("name", isolate_info.name);
+        heap.Set("threadId", isolate_info.thread_id);
+        heap.Set("usedHeapSize",
+                 static_cast<double>(isolate_info.used_heap_size >> 10));
+        heap.Set("totalHeapSize",
+                 static_cast<double>(isolate_info.total_heap_size >> 10));
+        heap.Set("heapSizeLimit",
+                 static_cast<double>(isolate_info.heap_size_limit >> 10));
+        isolates.push_back(heap);
+      }
+      dict.Set("isolates", isolates);
+    }
+    processes.push_back(dict);
+  }
+  process_metrics_cache_.Prune(pids);
+
+  callback.Run(mate::ConvertToV8(isolate(), processes));
+}
+
+void App::SetTabDiscardPolicy(const mate::Dictionary& options) {
+  auto tab_manager = GetGuestTabManager();
+  if (!tab_manager)
+    return;
+
+  memory::GuestTabManager::DiscardPolicy policy;
+  options.Get("memoryBudget", &policy.memory_budget);
+  int interval_ms;
+  if (options.Get("checkInterval", &interval_ms))
+    policy.check_interval = base::TimeDelta::FromMilliseconds(interval_ms);
+  int min_inactive_ms;
+  if (options.Get("minInactiveTime", &min_inactive_ms))
+    policy.min_inactive_time =
+        base::TimeDelta::FromMilliseconds(min_inactive_ms);
+  options.Get("maxDiscardsPerCheck", &policy.max_discards_per_check);
+  options.Get("protectPinned", &policy.protect_pinned);
+  options.Get("protectAudible", &policy.protect_audible);
+  options.Get("protectFormInput", &policy.protect_form_input);
+  tab_manager->SetDiscardPolicy(policy);
+}
+
+int App::DiscardTabs() {
+  auto tab_manager = GetGuestTabManager();
+  if (!tab_manager)
+    return 0;
+
+  return tab_manager->EnforceDiscardPolicy();
+}
+
+void App::SetMaxConcurrentTabLoads(int max_loads) {
+  auto tab_manager = GetGuestTabManager();
+  if (tab_manager)
+    tab_manager->set_max_concurrent_loads(max_loads);
+}
+
+void App::OnTabDiscarded(content::WebContents* old_contents,
+                         content::WebContents* new_contents,
+                         int64_t bytes_freed) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  auto details = mate::Dictionary::CreateEmpty(isolate());
+  details.Set("oldTabId", extensions::TabHelper::IdForTab(old_contents));
+  details.Set("bytesFreed", static_cast<double>(bytes_freed));
+  Emit("tab-discarded", extensions::TabHelper::IdForTab(new_contents),
+       details);
+}
+
+void App::OnTabRestored(content::WebContents* contents, int64_t bytes_freed) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  auto details = mate::Dictionary::CreateEmpty(isolate());
+  details.Set("bytesFreed", static_cast<double>(bytes_freed));
+  Emit("tab-restored", extensions::TabHelper::IdForTab(contents), details);
+}
+
 void App::PostMessage(int worker_id,
                       v8::Local<v8::Value> message,
                       mate::Arguments* args) {
@@ -955,6 +1098,10 @@ void App::BuildPrototype(
       .SetMethod("isAccessibilitySupportEnabled",
                  &App::IsAccessibilitySupportEnabled)
       .SetMethod("sendMemoryPressureAlert", &App::SendMemoryPressureAlert)
+      .SetMethod("getProcessMetrics", &App::GetProcessMetrics)
+      .SetMethod("setTabDiscardPolicy", &App::SetTabDiscardPolicy)
+      .SetMethod("discardTabs", &App::DiscardTabs)
+      .SetMethod("setMaxConcurrentTabLoads", &App::SetMaxConcurrentTabLoads)
       .SetMethod("_postMessage", &App::PostMessage)
       .SetMethod("_startWorker", &App::StartWorker)
       .SetMethod("stopWorker", &App::StopWorker)
@@ -9,9 +9,11 @@
 #include <string>
 
 #include "atom/browser/api/event_emitter.h"
+#include "atom/browser/api/process_metrics_collector.h"
 #include "atom/browser/atom_browser_client.h"
 #include "atom/browser/browser_observer.h"
 #include "atom/common/native_mate_converters/callback.h"
+#include "brave/browser/memory/guest_tab_manager.h"
 #include "chrome/browser/process_singleton.h"
 #include "content/public/browser/gpu_data_manager_observer.h"
 #include "content/public/browser/notification_observer.h"
@@ -41,7 +43,8 @@ class App : public AtomBrowserClient::Delegate,
             public BrowserObserver,
             public net::NetworkChangeNotifier::MaxBandwidthObserver,
             public content::GpuDataManagerObserver,
-            public content::NotificationObserver {
+            public content::NotificationObserver,
+            public memory::GuestTabManager::Observer {
  public:
   static mate::Handle<App> Create(v8::Isolate* isolate);
 
@@ -108,6 +111,13 @@ class App : public AtomBrowserClient::Delegate,
     int type, const content::NotificationSource& source,
     const content::NotificationDetails& details) override;
 
+  // memory::GuestTabManager::Observer:
+  void OnTabDiscarded(content::WebContents* old_contents,
+                      content::WebContents* new_contents,
+                      int64_t bytes_freed) override;
+  void OnTabRestored(content::WebContents* contents,
+                     int64_t bytes_freed) override;
+
  private:
   // Get/Set the pre-defined path in PathService.
   base::FilePath GetPath(mate::Arguments* args, const std::string& name);
@@ -125,6 +135,14 @@ class App : public AtomBrowserClient::Delegate,
   void DisableHardwareAcceleration(mate::Arguments* args);
   bool IsAccessibilitySupportEnabled();
   void SendMemoryPressureAlert();
+  void GetProcessMetrics(const base::Callback<void(v8::Local<v8::Value>)>&
+                             callback);
+  void OnProcessMetricsCollected(
+      const base::Callback<void(v8::Local<v8::Value>)>& callback,
+      const ProcessMetricsCollector* collector);
+  void SetTabDiscardPolicy(const mate::Dictionary& options);
+  int DiscardTabs();
+  void SetMaxConcurrentTabLoads(int max_loads);
   void PostMessage(int worker_id,
                   v8::Local<v8::Value> message,
                   mate::Arguments* args);
@@ -143,6 +161,8 @@ class App : public AtomBrowserClient::Delegate,
 
   std::unique_ptr<ProcessSingleton> process_singleton_;
 
+  ProcessMetricsCache process_metrics_cache_;
+
   DISALLOW_COPY_AND_ASSIGN(App);
 };
 
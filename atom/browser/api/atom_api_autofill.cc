@@ -4,6 +4,8 @@
 
 #include "atom/browser/api/atom_api_autofill.h"
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 #include "atom/browser/autofill/personal_data_manager_factory.h"
@@ -15,6 +17,7 @@
 #include "atom/common/node_includes.h"
 #include "base/guid.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/values.h"
 #include "brave/browser/brave_content_browser_client.h"
 #include "chrome/browser/password_manager/password_store_factory.h"
@@ -200,7 +203,10 @@ namespace api {
 Autofill::Autofill(v8::Isolate* isolate,
                  content::BrowserContext* browser_context)
       : browser_context_(browser_context),
-      weak_ptr_factory_(this) {
+      weak_ptr_factory_(this),
+      next_login_request_id_(0),
+      pending_login_batches_(0),
+      logins_changed_during_batch_(false) {
   Init(isolate);
   personal_data_manager_ =
       autofill::PersonalDataManagerFactory::GetForBrowserContext(
@@ -543,6 +549,160 @@ void Autofill::ClearLogins() {
                                       base::Closure());
 }
 
+void Autofill::GetLogins(mate::Arguments* args) {
+  mate::Dictionary options;
+  PasswordFormPageCallback callback;
+  if (!args->GetNext(&options) || !args->GetNext(&callback)) {
+    args->ThrowError("`options` and `callback` are required fields");
+    return;
+  }
+
+  GURL origin;
+  bool blacklisted = false;
+  int offset = 0;
+  int limit = -1;
+  options.Get("origin", &origin);
+  options.Get("blacklisted", &blacklisted);
+  options.Get("offset", &offset);
+  options.Get("limit", &limit);
+
+  password_manager::PasswordStore* store = GetPasswordStore();
+  if (!store) {
+    callback.Run(std::vector<std::unique_ptr<autofill::PasswordForm>>(), 0);
+    return;
+  }
+
+  int request_id = next_login_request_id_++;
+  BravePasswordStoreConsumer* consumer = TrackLoginRequest(
+      request_id,
+      base::Bind(&Autofill::OnGetLogins, weak_ptr_factory_.GetWeakPtr(),
+                 request_id, blacklisted,
+                 static_cast<size_t>(std::max(offset, 0)),
+                 limit < 0 ? std::numeric_limits<size_t>::max()
+                           : static_cast<size_t>(limit),
+                 callback));
+  if (origin.is_valid()) {
+    // Only the logins of the origin are read from the store.
+    store->GetLogins(password_manager::PasswordStore::FormDigest(
+                         autofill::PasswordForm::SCHEME_HTML,
+                         origin.GetOrigin().spec(), origin),
+                     consumer);
+  } else if (blacklisted) {
+    store->GetBlacklistLogins(consumer);
+  } else {
+    store->GetAutofillableLogins(consumer);
+  }
+}
+
+void Autofill::OnGetLogins(
+    int request_id,
+    bool blacklisted,
+    size_t offset,
+    size_t limit,
+    const PasswordFormPageCallback& callback,
+    std::vector<std::unique_ptr<autofill::PasswordForm>> results) {
+  ReleaseLoginRequest(request_id);
+
+  // Only the requested page is converted for JavaScript.
+  std::vector<std::unique_ptr<autofill::PasswordForm>> page;
+  size_t matched = 0;
+  for (auto& form : results) {
+    if (form->blacklisted_by_user != blacklisted)
+      continue;
+    if (matched >= offset && matched - offset < limit)
+      page.push_back(std::move(form));
+    ++matched;
+  }
+  callback.Run(std::move(page), static_cast<int>(matched));
+}
+
+void Autofill::AddLogins(mate::Arguments* args) {
+  ChangeLogins(ADD_LOGIN, args);
+}
+
+void Autofill::UpdateLogins(mate::Arguments* args) {
+  ChangeLogins(UPDATE_LOGIN, args);
+}
+
+void Autofill::RemoveLogins(mate::Arguments* args) {
+  ChangeLogins(REMOVE_LOGIN, args);
+}
+
+void Autofill::ChangeLogins(LoginAction action, mate::Arguments* args) {
+  std::vector<autofill::PasswordForm> forms;
+  if (!args->GetNext(&forms)) {
+    args->ThrowError("`forms` is a required field");
+    return;
+  }
+  base::Closure callback;
+  args->GetNext(&callback);
+
+  password_manager::PasswordStore* store = GetPasswordStore();
+  if (!store || forms.empty()) {
+    if (!callback.is_null())
+      callback.Run();
+    return;
+  }
+
+  pending_login_batches_++;
+  for (const auto& form : forms) {
+    switch (action) {
+      case ADD_LOGIN:
+        store->AddLogin(form);
+        break;
+      case UPDATE_LOGIN:
+        store->UpdateLogin(form);
+        break;
+      case REMOVE_LOGIN:
+        store->RemoveLogin(form);
+        break;
+    }
+  }
+
+  // The store runs its tasks in order, so this read is answered after every
+  // change of the batch has been written and reported.
+  int request_id = next_login_request_id_++;
+  store->GetLogins(
+      password_manager::PasswordStore::FormDigest(forms.back()),
+      TrackLoginRequest(request_id,
+                        base::Bind(&Autofill::OnLoginBatchDone,
+                                   weak_ptr_factory_.GetWeakPtr(),
+                                   request_id, callback)));
+}
+
+void Autofill::OnLoginBatchDone(
+    int request_id,
+    const base::Closure& callback,
+    std::vector<std::unique_ptr<autofill::PasswordForm>>) {
+  ReleaseLoginRequest(request_id);
+
+  DCHECK_GT(pending_login_batches_, 0);
+  if (--pending_login_batches_ == 0 && logins_changed_during_batch_) {
+    logins_changed_during_batch_ = false;
+    RefreshLoginLists();
+  }
+  if (!callback.is_null())
+    callback.Run();
+}
+
+BravePasswordStoreConsumer* Autofill::TrackLoginRequest(
+    int request_id, const PasswordFormCallback& callback) {
+  std::unique_ptr<BravePasswordStoreConsumer>& consumer =
+      login_requests_[request_id];
+  consumer.reset(new BravePasswordStoreConsumer(callback));
+  return consumer.get();
+}
+
+void Autofill::ReleaseLoginRequest(int request_id) {
+  auto it = login_requests_.find(request_id);
+  if (it == login_requests_.end())
+    return;
+  // The consumer is still delivering the results.
+  base::ThreadTaskRunnerHandle::Get()->DeleteSoon(FROM_HERE,
+                                                  it->second.release());
+  login_requests_.erase(it);
+}
+
 void Autofill::OnPersonalDataChanged() {
   std::vector<autofill::AutofillProfile*> profiles =
     personal_data_manager_->GetProfiles();
@@ -568,6 +728,14 @@ void Autofill::OnPersonalDataChanged() {
 }
 void Autofill::OnLoginsChanged(
     const password_manager::PasswordStoreChangeList& changes) {
+  if (pending_login_batches_) {
+    logins_changed_during_batch_ = true;
+    return;
+  }
+  RefreshLoginLists();
+}
+
+void Autofill::RefreshLoginLists() {
   password_manager::PasswordStore* store = GetPasswordStore();
   if (store) {
     BravePasswordStoreConsumer* password_list_consumer =
@@ -606,7 +774,11 @@ void Autofill::BuildPrototype(v8::Isolate* isolate,
     .SetMethod("addLogin", &Autofill::AddLogin)
     .SetMethod("updateLogin", &Autofill::UpdateLogin)
     .SetMethod("removeLogin", &Autofill::RemoveLogin)
-    .SetMethod("clearLogins", &Autofill::ClearLogins);
+    .SetMethod("clearLogins", &Autofill::ClearLogins)
+    .SetMethod("getLogins", &Autofill::GetLogins)
+    .SetMethod("addLogins", &Autofill::AddLogins)
+    .SetMethod("updateLogins", &Autofill::UpdateLogins)
+    .SetMethod("removeLogins", &Autofill::RemoveLogins);
 }
 
 }  // namespace api
@@ -5,6 +5,7 @@
 #ifndef ATOM_BROWSER_API_ATOM_API_AUTOFILL_H_
 #define ATOM_BROWSER_API_ATOM_API_AUTOFILL_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -34,6 +35,11 @@ class BraveBrowserContext;
 using PasswordFormCallback =
   base::Callback<void(std::vector<std::unique_ptr<autofill::PasswordForm>>)>;
 
+// Receives one page of logins and the number of logins that matched.
+using PasswordFormPageCallback =
+  base::Callback<void(std::vector<std::unique_ptr<autofill::PasswordForm>>,
+                      int)>;
+
 class BravePasswordStoreConsumer
   : public password_manager::PasswordStoreConsumer {
  public:
@@ -91,6 +97,12 @@ class Autofill : public mate::TrackableObject<Autofill>,
 
   void ClearLogins();
 
+  void GetLogins(mate::Arguments* args);
+
+  void AddLogins(mate::Arguments* args);
+  void UpdateLogins(mate::Arguments* args);
+  void RemoveLogins(mate::Arguments* args);
+
   // PersonalDataManagerObserver
   void OnPersonalDataChanged() override;
 
@@ -101,9 +113,37 @@ class Autofill : public mate::TrackableObject<Autofill>,
   Profile* profile();
   password_manager::PasswordStore* GetPasswordStore();
  private:
+  enum LoginAction {
+    ADD_LOGIN,
+    UPDATE_LOGIN,
+    REMOVE_LOGIN,
+  };
+
   void OnClearedAutocompleteData();
   void OnClearedAutofillData();
 
+  // Refreshes the lists requested by getAutofillableLogins and
+  // getBlackedlistLogins.
+  void RefreshLoginLists();
+
+  void ChangeLogins(LoginAction action, mate::Arguments* args);
+  void OnLoginBatchDone(int request_id,
+                        const base::Closure& callback,
+                        std::vector<std::unique_ptr<autofill::PasswordForm>>);
+
+  void OnGetLogins(int request_id,
+                   bool blacklisted,
+                   size_t offset,
+                   size_t limit,
+                   const PasswordFormPageCallback& callback,
+                   std::vector<std::unique_ptr<autofill::PasswordForm>>);
+
+  // Creates the consumer of a one-shot PasswordStore request, it stays alive
+  // until ReleaseLoginRequest(|request_id|).
+  BravePasswordStoreConsumer* TrackLoginRequest(
+      int request_id, const PasswordFormCallback& callback);
+  void ReleaseLoginRequest(int request_id);
+
   content::BrowserContext* browser_context_;  // not owned
 
   autofill::PersonalDataManager* personal_data_manager_;  // not owned
@@ -114,6 +154,14 @@ class Autofill : public mate::TrackableObject<Autofill>,
 
   std::unique_ptr<BravePasswordStoreConsumer> password_blacked_list_consumer_;
 
+  int next_login_request_id_;
+  std::map<int, std::unique_ptr<BravePasswordStoreConsumer>> login_requests_;
+
+  // Batches whose changes have not all been reported yet, the login lists are
+  // refreshed once the last of them is done instead of after every change.
+  int pending_login_batches_;
+  bool logins_changed_during_batch_;
+
   DISALLOW_COPY_AND_ASSIGN(Autofill);
 };
 
@@ -0,0 +1,82 @@
+// Copyright (c) 2017 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "atom/browser/atom_browser_context.h"
+#include "atom/browser/crash_report_uploader.h"
+#include "atom/common/native_mate_converters/callback.h"
+#include "atom/common/native_mate_converters/file_path_converter.h"
+#include "atom/common/native_mate_converters/gurl_converter.h"
+#include "base/values.h"
+#include "brave/browser/brave_browser_context.h"
+#include "native_mate/dictionary.h"
+
+#include "atom/common/node_includes.h"
+
+using atom::CrashReportUploader;
+
+namespace mate {
+
+template<>
+struct Converter<CrashReportUploader::Result> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const CrashReportUploader::Result& result) {
+    mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+    dict.Set("uploaded", result.uploaded);
+    dict.Set("failed", result.failed);
+    dict.Set("pruned", result.pruned);
+    return dict.GetHandle();
+  }
+};
+
+}  // namespace mate
+
+namespace {
+
+// Only one uploader runs at a time, starting a new one stops the previous.
+CrashReportUploader* g_uploader = nullptr;
+
+void Upload(const mate::Dictionary& options,
+            const CrashReportUploader::Callback& callback,
+            mate::Arguments* args) {
+  CrashReportUploader::Options uploader_options;
+  if (!options.Get("directory", &uploader_options.directory) ||
+      !options.Get("submitURL", &uploader_options.upload_url)) {
+    args->ThrowError("directory and submitURL are required");
+    return;
+  }
+  options.Get("compress", &uploader_options.compress);
+  int max_reports;
+  if (options.Get("maxReports", &max_reports) && max_reports >= 0)
+    uploader_options.max_reports = max_reports;
+  double max_report_size;
+  if (options.Get("maxReportSize", &max_report_size) && max_report_size > 0)
+    uploader_options.max_report_size = static_cast<int64_t>(max_report_size);
+  int max_age;
+  if (options.Get("maxAge", &max_age) && max_age > 0)
+    uploader_options.max_age = base::TimeDelta::FromSeconds(max_age);
+  int max_attempts;
+  if (options.Get("maxAttempts", &max_attempts) && max_attempts > 0)
+    uploader_options.max_attempts = max_attempts;
+
+  atom::AtomBrowserContext* browser_context =
+      brave::BraveBrowserContext::FromPartition("", base::DictionaryValue());
+
+  delete g_uploader;
+  g_uploader = new CrashReportUploader(uploader_options,
+                                       browser_context->GetRequestContext());
+  g_uploader->Start(callback);
+}
+
+void Initialize(v8::Local<v8::Object> exports, v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context, void* priv) {
+  mate::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("upload", &Upload);
+}
+
+}  // namespace
+
+NODE_MODULE_CONTEXT_AWARE_BUILTIN(atom_browser_crash_report_uploader,
+                                  Initialize)
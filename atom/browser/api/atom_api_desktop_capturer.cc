@@ -3,14 +3,19 @@
 // found in the LICENSE file.
 
 #include <memory>
+#include <set>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "atom/browser/api/atom_api_desktop_capturer.h"
 
 #include "atom/common/api/atom_api_native_image.h"
 #include "atom/common/native_mate_converters/gfx_converter.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "chrome/browser/media/webrtc/desktop_media_list.h"
+#include "native_mate/arguments.h"
 #include "native_mate/dictionary.h"
 #include "third_party/webrtc/modules/desktop_capture/desktop_capture_options.h"
 #include "third_party/webrtc/modules/desktop_capture/desktop_capturer.h"
@@ -40,7 +45,8 @@ namespace atom {
 
 namespace api {
 
-DesktopCapturer::DesktopCapturer(v8::Isolate* isolate) {
+DesktopCapturer::DesktopCapturer(v8::Isolate* isolate)
+    : continuous_(false), emitting_(false) {
   Init(isolate);
 }
 
@@ -49,7 +55,11 @@ DesktopCapturer::~DesktopCapturer() {
 
 void DesktopCapturer::StartHandling(bool capture_window,
                                     bool capture_screen,
-                                    const gfx::Size& thumbnail_size) {
+                                    const gfx::Size& thumbnail_size,
+                                    mate::Arguments* args) {
+  mate::Dictionary handling_options;
+  args->GetNext(&handling_options);
+
   webrtc::DesktopCaptureOptions options =
       webrtc::DesktopCaptureOptions::CreateDefault();
 
@@ -71,11 +81,41 @@ void DesktopCapturer::StartHandling(bool capture_window,
       capture_window
       ? webrtc::DesktopCapturer::CreateScreenCapturer(options)
       : nullptr);
-  media_list_.reset(new NativeDesktopMediaList(
+  std::unique_ptr<NativeDesktopMediaList> media_list(new NativeDesktopMediaList(
       std::move(screen_capturer), std::move(window_capturer)));
 
-  media_list_->SetThumbnailSize(thumbnail_size);
-  media_list_->StartUpdating(this);
+  // A refresh interval keeps the list updating until stopHandling() is
+  // called, unchanged sources do not get a new thumbnail.
+  int refresh_interval = 0;
+  continuous_ = handling_options.Get("refreshInterval", &refresh_interval) &&
+                refresh_interval > 0;
+  if (continuous_)
+    media_list->SetUpdatePeriod(
+        base::TimeDelta::FromMilliseconds(refresh_interval));
+
+  std::vector<std::string> source_ids;
+  if (handling_options.Get("sourceIds", &source_ids)) {
+    std::set<content::DesktopMediaID> filter;
+    for (const auto& source_id : source_ids) {
+      content::DesktopMediaID id = content::DesktopMediaID::Parse(source_id);
+      if (!id.is_null())
+        filter.insert(id);
+    }
+    media_list->SetSourceFilter(filter);
+  }
+
+  StopHandling();
+  media_list->SetThumbnailSize(thumbnail_size);
+  media_list->StartUpdating(this);
+  media_list_ = std::move(media_list);
+}
+
+void DesktopCapturer::StopHandling() {
+  // The "finished" event is emitted while the list is still on the stack.
+  if (emitting_ && media_list_)
+    base::ThreadTaskRunnerHandle::Get()->DeleteSoon(FROM_HERE,
+                                                    media_list_.release());
+  media_list_.reset();
 }
 
 void DesktopCapturer::OnSourceAdded(int index) {
@@ -94,8 +134,12 @@ void DesktopCapturer::OnSourceThumbnailChanged(int index) {
 }
 
 bool DesktopCapturer::OnRefreshFinished() {
-  Emit("finished", media_list_->GetSources());
-  return false;
+  DesktopMediaList* media_list = media_list_.get();
+  emitting_ = true;
+  Emit("finished", media_list->GetSources());
+  emitting_ = false;
+  // The handler may have stopped or restarted the capturer.
+  return continuous_ && media_list_.get() == media_list;
 }
 
 // static
@@ -108,7 +152,8 @@ void DesktopCapturer::BuildPrototype(
     v8::Isolate* isolate, v8::Local<v8::FunctionTemplate> prototype) {
   prototype->SetClassName(mate::StringToV8(isolate, "DesktopCapturer"));
   mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
-      .SetMethod("startHandling", &DesktopCapturer::StartHandling);
+      .SetMethod("startHandling", &DesktopCapturer::StartHandling)
+      .SetMethod("stopHandling", &DesktopCapturer::StopHandling);
 }
 
 }  // namespace api
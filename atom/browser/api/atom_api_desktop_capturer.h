@@ -12,6 +12,10 @@
 #include "chrome/browser/media/webrtc/native_desktop_media_list.h"
 #include "native_mate/handle.h"
 
+namespace mate {
+class Arguments;
+}
+
 namespace atom {
 
 namespace api {
@@ -26,7 +30,9 @@ class DesktopCapturer: public mate::EventEmitter<DesktopCapturer>,
 
   void StartHandling(bool capture_window,
                      bool capture_screen,
-                     const gfx::Size& thumbnail_size);
+                     const gfx::Size& thumbnail_size,
+                     mate::Arguments* args);
+  void StopHandling();
 
  protected:
   explicit DesktopCapturer(v8::Isolate* isolate);
@@ -43,6 +49,11 @@ class DesktopCapturer: public mate::EventEmitter<DesktopCapturer>,
  private:
   std::unique_ptr<DesktopMediaList> media_list_;
 
+  // Whether the list keeps refreshing after the first "finished" event.
+  bool continuous_;
+  // Set while the "finished" event is emitted.
+  bool emitting_;
+
   DISALLOW_COPY_AND_ASSIGN(DesktopCapturer);
 };
 
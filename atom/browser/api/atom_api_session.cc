@@ -23,6 +23,7 @@
 #include "atom/browser/atom_browser_main_parts.h"
 #include "atom/browser/browser.h"
 #include "atom/browser/net/atom_cert_verifier.h"
+#include "atom/browser/net/atom_network_delegate.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/content_converter.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
@@ -32,13 +33,14 @@
 #include "atom/common/node_includes.h"
 #include "base/files/file_path.h"
 #include "base/guid.h"
-#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/task/cancelable_task_tracker.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "brave/browser/brave_content_browser_client.h"
 #include "brave/browser/brave_permission_manager.h"
+#include "brightray/browser/browser_client.h"
+#include "brightray/browser/net_log.h"
 #include "chrome/browser/devtools/devtools_network_conditions.h"
 #include "chrome/browser/devtools/devtools_network_controller_handle.h"
 #include "chrome/browser/history/history_service_factory.h"
@@ -51,11 +53,18 @@
 #include "extensions/features/features.h"
 #include "native_mate/dictionary.h"
 #include "native_mate/object_template_builder.h"
+#include "net/base/address_list.h"
+#include "net/base/host_port_pair.h"
 #include "net/base/load_flags.h"
 #include "net/disk_cache/disk_cache.h"
 #include "net/dns/host_cache.h"
+#include "net/dns/host_resolver.h"
 #include "net/http/http_auth_handler_factory.h"
 #include "net/http/http_auth_preferences.h"
+#include "net/http/http_network_session.h"
+#include "net/http/http_request_info.h"
+#include "net/http/http_stream_factory.h"
+#include "net/http/http_transaction_factory.h"
 #include "net/proxy/proxy_config_service_fixed.h"
 #include "net/proxy/proxy_service.h"
 #include "net/url_request/static_http_user_agent_settings.h"
@@ -237,6 +246,38 @@ class ResolveProxyHelper {
   DISALLOW_COPY_AND_ASSIGN(ResolveProxyHelper);
 };
 
+// Resolves a host to warm up the host cache, deletes itself when done.
+class PrefetchDNSHelper {
+ public:
+  PrefetchDNSHelper() {}
+
+  void Resolve(net::HostResolver* host_resolver, const std::string& host) {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+
+    net::HostResolver::RequestInfo request_info(net::HostPortPair(host, 80));
+    request_info.set_is_speculative(true);
+    int result = host_resolver->Resolve(
+        request_info, net::IDLE, &addresses_,
+        base::Bind(&PrefetchDNSHelper::OnResolveCompleted,
+                   base::Unretained(this)),
+        &request_, net::NetLogWithSource());
+
+    // Completed synchronously.
+    if (result != net::ERR_IO_PENDING)
+      OnResolveCompleted(result);
+  }
+
+ private:
+  void OnResolveCompleted(int result) {
+    delete this;
+  }
+
+  net::AddressList addresses_;
+  std::unique_ptr<net::HostResolver::Request> request_;
+
+  DISALLOW_COPY_AND_ASSIGN(PrefetchDNSHelper);
+};
+
 // Runs the callback in UI thread.
 template<typename ...T>
 void RunCallbackInUI(const base::Callback<void(T...)>& callback, T... result) {
@@ -256,16 +297,12 @@ void OnGetBackend(disk_cache::Backend** backend_ptr,
       (*backend_ptr)->DoomAllEntries(base::Bind(&RunCallbackInUI<int>,
                                                 callback));
     } else if (action == Session::CacheAction::STATS) {
-      base::StringPairs stats;
-      (*backend_ptr)->GetStats(&stats);
-      for (const auto& stat : stats) {
-        if (stat.first == "Current size") {
-          int current_size;
-          base::StringToInt(stat.second, &current_size);
-          RunCallbackInUI(callback, current_size);
-          break;
-        }
-      }
+      // Unlike the "Current size" entry of GetStats, this is implemented by
+      // every backend type, including the simple and in-memory caches.
+      int rv = (*backend_ptr)->CalculateSizeOfAllEntries(
+          base::Bind(&RunCallbackInUI<int>, callback));
+      if (rv != net::ERR_IO_PENDING)
+        RunCallbackInUI(callback, rv);
     }
   } else {
     RunCallbackInUI<int>(callback, net::ERR_FAILED);
@@ -291,6 +328,30 @@ void DoCacheActionInIO(
     on_get_backend.Run(net::OK);
 }
 
+void OnGetStats(
+    const base::Callback<void(const base::DictionaryValue&)>& callback,
+    std::unique_ptr<base::DictionaryValue> stats) {
+  callback.Run(*stats);
+}
+
+void GetCacheStatsInIO(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter,
+    const base::Callback<void(const base::DictionaryValue&)>& callback) {
+  auto delegate = static_cast<AtomNetworkDelegate*>(
+      context_getter->GetURLRequestContext()->network_delegate());
+  const AtomNetworkDelegate::CacheStats& cache_stats =
+      delegate->cache_stats();
+
+  std::unique_ptr<base::DictionaryValue> stats(new base::DictionaryValue);
+  stats->SetDouble("hits", cache_stats.hits);
+  stats->SetDouble("misses", cache_stats.misses);
+  stats->SetDouble("bytesFromCache", cache_stats.bytes_from_cache);
+  stats->SetDouble("bytesFromNetwork", cache_stats.bytes_from_network);
+  BrowserThread::PostTask(
+      BrowserThread::UI, FROM_HERE,
+      base::Bind(&OnGetStats, callback, base::Passed(&stats)));
+}
+
 void SetProxyInIO(scoped_refptr<net::URLRequestContextGetter> getter,
                   const net::ProxyConfig& config,
                   const base::Closure& callback) {
@@ -325,6 +386,61 @@ void ClearHostResolverCacheInIO(
   }
 }
 
+void PreconnectInIO(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter,
+    const GURL& url,
+    int num_sockets) {
+  auto request_context = context_getter->GetURLRequestContext();
+  auto http_session =
+      request_context->http_transaction_factory()->GetSession();
+  if (!http_session)
+    return;
+
+  net::HttpRequestInfo request_info;
+  request_info.url = url;
+  request_info.method = "GET";
+  if (request_context->http_user_agent_settings()) {
+    request_info.extra_headers.SetHeader(
+        net::HttpRequestHeaders::kUserAgent,
+        request_context->http_user_agent_settings()->GetUserAgent());
+  }
+  request_info.motivation = net::HttpRequestInfo::PRECONNECT_MOTIVATED;
+
+  static_cast<AtomNetworkDelegate*>(
+      request_context->network_delegate())->OnPreconnect(num_sockets);
+  http_session->http_stream_factory()->PreconnectStreams(num_sockets,
+                                                         request_info);
+}
+
+void PrefetchDNSInIO(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter,
+    const std::vector<std::string>& hosts) {
+  auto host_resolver = context_getter->GetURLRequestContext()->host_resolver();
+  for (const auto& host : hosts)
+    (new PrefetchDNSHelper)->Resolve(host_resolver, host);
+}
+
+void GetPreconnectStatsInIO(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter,
+    const base::Callback<void(const base::DictionaryValue&)>& callback) {
+  auto delegate = static_cast<AtomNetworkDelegate*>(
+      context_getter->GetURLRequestContext()->network_delegate());
+  const AtomNetworkDelegate::PreconnectStats& preconnect_stats =
+      delegate->preconnect_stats();
+
+  std::unique_ptr<base::DictionaryValue> stats(new base::DictionaryValue);
+  stats->SetDouble("socketsRequested", preconnect_stats.sockets_requested);
+  stats->SetDouble("socketsUsed", preconnect_stats.sockets_used);
+  BrowserThread::PostTask(
+      BrowserThread::UI, FROM_HERE,
+      base::Bind(&OnGetStats, callback, base::Passed(&stats)));
+}
+
+brightray::NetLog* GetNetLog() {
+  return static_cast<brightray::NetLog*>(
+      brightray::BrowserClient::Get()->GetNetLog());
+}
+
 void AllowNTLMCredentialsForDomainsInIO(
     const scoped_refptr<net::URLRequestContextGetter>& context_getter,
     const std::string& domains) {
@@ -400,6 +516,12 @@ void Session::DoCacheAction(const net::CompletionCallback& callback) {
                  callback));
 }
 
+void Session::GetCacheStats(
+    const base::Callback<void(const base::DictionaryValue&)>& callback) {
+  BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+      base::Bind(&GetCacheStatsInIO, request_context_getter_, callback));
+}
+
 void Session::ClearStorageData(mate::Arguments* args) {
   // clearStorageData([options, callback])
   ClearStorageDataOptions options;
@@ -517,6 +639,37 @@ void Session::ClearHostResolverCache(mate::Arguments* args) {
                  callback));
 }
 
+void Session::Preconnect(const GURL& url, mate::Arguments* args) {
+  if (!url.SchemeIsHTTPOrHTTPS()) {
+    args->ThrowError("Only http and https URLs can be preconnected");
+    return;
+  }
+
+  int num_sockets = 1;
+  mate::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("numSockets", &num_sockets);
+  if (num_sockets < 1)
+    return;
+
+  BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+      base::Bind(&PreconnectInIO,
+                 request_context_getter_,
+                 url,
+                 num_sockets));
+}
+
+void Session::PrefetchDNS(const std::vector<std::string>& hosts) {
+  BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+      base::Bind(&PrefetchDNSInIO, request_context_getter_, hosts));
+}
+
+void Session::GetPreconnectStats(
+    const base::Callback<void(const base::DictionaryValue&)>& callback) {
+  BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+      base::Bind(&GetPreconnectStatsInIO, request_context_getter_, callback));
+}
+
 void Session::AllowNTLMCredentialsForDomains(const std::string& domains) {
   BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
       base::Bind(&AllowNTLMCredentialsForDomainsInIO,
@@ -524,6 +677,55 @@ void Session::AllowNTLMCredentialsForDomains(const std::string& domains) {
                  domains));
 }
 
+void Session::SetNetLogFilter(const std::vector<std::string>& types,
+                              mate::Arguments* args) {
+  auto ring_buffer = GetNetLog()->ring_buffer();
+  if (!ring_buffer) {
+    args->ThrowError("The net log buffer is disabled");
+    return;
+  }
+
+  std::set<net::NetLogEventType> filter;
+  for (const auto& name : types) {
+    bool found = false;
+    for (size_t i = 0;
+         i < static_cast<size_t>(net::NetLogEventType::COUNT); ++i) {
+      auto type = static_cast<net::NetLogEventType>(i);
+      if (name == net::NetLog::EventTypeToString(type)) {
+        filter.insert(type);
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      args->ThrowError("Unknown net log event type: " + name);
+      return;
+    }
+  }
+  ring_buffer->SetEventTypeFilter(filter);
+}
+
+void Session::DumpNetLog(const base::FilePath& path,
+                         const base::Callback<void(bool)>& callback) {
+  GetNetLog()->DumpRingBuffer(path, callback);
+}
+
+v8::Local<v8::Value> Session::GetNetLogStats(v8::Isolate* isolate) {
+  auto ring_buffer = GetNetLog()->ring_buffer();
+  if (!ring_buffer)
+    return v8::Null(isolate);
+
+  brightray::NetLogRingBuffer::Stats stats = ring_buffer->GetStats();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("capacity", static_cast<double>(stats.capacity));
+  dict.Set("size", static_cast<double>(stats.size));
+  dict.Set("captured", static_cast<double>(stats.captured));
+  dict.Set("filtered", static_cast<double>(stats.filtered));
+  dict.Set("evicted", static_cast<double>(stats.evicted));
+  dict.Set("captureTime", stats.capture_time.InMillisecondsF());
+  return dict.GetHandle();
+}
+
 void Session::SetEnableBrotli(bool enabled) {
   request_context_getter_->GetNetworkTaskRunner()->PostTask(
       FROM_HERE,
@@ -651,6 +853,7 @@ void Session::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("resolveProxy", &Session::ResolveProxy)
       .SetMethod("getCacheSize", &Session::DoCacheAction<CacheAction::STATS>)
       .SetMethod("clearCache", &Session::DoCacheAction<CacheAction::CLEAR>)
+      .SetMethod("getCacheStats", &Session::GetCacheStats)
       .SetMethod("clearStorageData", &Session::ClearStorageData)
       .SetMethod("clearHistory", &Session::ClearHistory)
       .SetMethod("flushStorageData", &Session::FlushStorageData)
@@ -662,9 +865,15 @@ void Session::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("setPermissionRequestHandler",
                  &Session::SetPermissionRequestHandler)
       .SetMethod("clearHostResolverCache", &Session::ClearHostResolverCache)
+      .SetMethod("preconnect", &Session::Preconnect)
+      .SetMethod("prefetchDNS", &Session::PrefetchDNS)
+      .SetMethod("getPreconnectStats", &Session::GetPreconnectStats)
       .SetMethod("allowNTLMCredentialsForDomains",
                  &Session::AllowNTLMCredentialsForDomains)
       .SetMethod("setEnableBrotli", &Session::SetEnableBrotli)
+      .SetMethod("setNetLogFilter", &Session::SetNetLogFilter)
+      .SetMethod("dumpNetLog", &Session::DumpNetLog)
+      .SetMethod("getNetLogStats", &Session::GetNetLogStats)
       .SetMethod("equal", &Session::Equal)
       .SetProperty("partition", &Session::Partition)
       .SetProperty("contentSettings", &Session::ContentSettings)
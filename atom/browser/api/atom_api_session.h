@@ -6,6 +6,7 @@
 #define ATOM_BROWSER_API_ATOM_API_SESSION_H_
 
 #include <string>
+#include <vector>
 
 #include "atom/browser/api/trackable_object.h"
 #include "base/task/cancelable_task_tracker.h"
@@ -69,6 +70,8 @@ class Session: public mate::TrackableObject<Session>,
   void ResolveProxy(const GURL& url, ResolveProxyCallback callback);
   template<CacheAction action>
   void DoCacheAction(const net::CompletionCallback& callback);
+  void GetCacheStats(
+      const base::Callback<void(const base::DictionaryValue&)>& callback);
   void ClearStorageData(mate::Arguments* args);
   void ClearHistory(mate::Arguments* args);
   void FlushStorageData();
@@ -80,9 +83,18 @@ class Session: public mate::TrackableObject<Session>,
   void SetPermissionRequestHandler(v8::Local<v8::Value> val,
                                    mate::Arguments* args);
   void ClearHostResolverCache(mate::Arguments* args);
+  void Preconnect(const GURL& url, mate::Arguments* args);
+  void PrefetchDNS(const std::vector<std::string>& hosts);
+  void GetPreconnectStats(
+      const base::Callback<void(const base::DictionaryValue&)>& callback);
   void AllowNTLMCredentialsForDomains(const std::string& domains);
   std::string Partition();
   void SetEnableBrotli(bool enabled);
+  void SetNetLogFilter(const std::vector<std::string>& types,
+                       mate::Arguments* args);
+  void DumpNetLog(const base::FilePath& path,
+                  const base::Callback<void(bool)>& callback);
+  v8::Local<v8::Value> GetNetLogStats(v8::Isolate* isolate);
   v8::Local<v8::Value> ContentSettings(v8::Isolate* isolate);
   v8::Local<v8::Value> Cookies(v8::Isolate* isolate);
   v8::Local<v8::Value> Protocol(v8::Isolate* isolate);
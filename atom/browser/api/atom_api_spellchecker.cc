@@ -6,23 +6,53 @@
 
 #include <string>
 
+#include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/node_includes.h"
+#include "base/bind.h"
+#include "base/strings/string_util.h"
 #include "chrome/browser/spellchecker/spellcheck_factory.h"
 #include "chrome/browser/spellchecker/spellcheck_service.h"
+#include "components/sync/model/sync_change.h"
+#include "components/sync/model/sync_data.h"
+#include "components/sync/protocol/sync.pb.h"
 #include "native_mate/dictionary.h"
 
 namespace atom {
 
 namespace api {
 
+namespace {
+
+// Same limit as the one the custom dictionary applies to its words.
+const size_t kMaxWordBytes = 99;
+
+// The dictionary drops words it would reject anyway, but an empty word makes
+// an invalid sync change that trips a DCHECK before it gets the chance.
+bool IsValidWord(const std::string& word) {
+  std::string trimmed;
+  return !word.empty() && word.size() <= kMaxWordBytes &&
+         base::IsStringUTF8(word) &&
+         base::TrimWhitespaceASCII(word, base::TRIM_ALL, &trimmed) ==
+             base::TRIM_NONE;
+}
+
+}  // namespace
+
 SpellChecker::SpellChecker(v8::Isolate* isolate,
                  content::BrowserContext* browser_context)
       : browser_context_(browser_context),
+      observing_dictionary_(false),
       weak_ptr_factory_(this) {
   Init(isolate);
 }
 
-SpellChecker::~SpellChecker() {}
+SpellChecker::~SpellChecker() {
+  if (observing_dictionary_) {
+    SpellcheckCustomDictionary* dictionary = GetCustomDictionary();
+    if (dictionary)
+      dictionary->RemoveObserver(this);
+  }
+}
 
 void SpellChecker::AddWord(mate::Arguments* args) {
   if (args->Length() != 1) {
@@ -66,6 +96,181 @@ void SpellChecker::RemoveWord(mate::Arguments* args) {
   }
 }
 
+void SpellChecker::AddWords(mate::Arguments* args) {
+  if (args->Length() != 1) {
+    args->ThrowError("Wrong number of arguments");
+    return;
+  }
+
+  std::vector<std::string> words;
+  if (!args->GetNext(&words)) {
+    args->ThrowError("words is a required field");
+    return;
+  }
+
+  RunWhenLoaded(base::Bind(&SpellChecker::ApplyChange,
+                           weak_ptr_factory_.GetWeakPtr(),
+                           std::set<std::string>(words.begin(), words.end()),
+                           std::set<std::string>()));
+}
+
+void SpellChecker::RemoveWords(mate::Arguments* args) {
+  if (args->Length() != 1) {
+    args->ThrowError("Wrong number of arguments");
+    return;
+  }
+
+  std::vector<std::string> words;
+  if (!args->GetNext(&words)) {
+    args->ThrowError("words is a required field");
+    return;
+  }
+
+  RunWhenLoaded(base::Bind(&SpellChecker::ApplyChange,
+                           weak_ptr_factory_.GetWeakPtr(),
+                           std::set<std::string>(),
+                           std::set<std::string>(words.begin(), words.end())));
+}
+
+void SpellChecker::SetWords(mate::Arguments* args) {
+  if (args->Length() != 1) {
+    args->ThrowError("Wrong number of arguments");
+    return;
+  }
+
+  std::vector<std::string> words;
+  if (!args->GetNext(&words)) {
+    args->ThrowError("words is a required field");
+    return;
+  }
+
+  RunWhenLoaded(base::Bind(&SpellChecker::ReplaceWords,
+                           weak_ptr_factory_.GetWeakPtr(),
+                           std::set<std::string>(words.begin(), words.end())));
+}
+
+std::vector<std::string> SpellChecker::GetWords(mate::Arguments* args) {
+  WordsCallback callback;
+  if (args->GetNext(&callback)) {
+    RunWhenLoaded(base::Bind(&SpellChecker::RunWordsCallback,
+                             weak_ptr_factory_.GetWeakPtr(), callback));
+  }
+
+  SpellcheckCustomDictionary* dictionary = GetCustomDictionary();
+  if (!dictionary)
+    return std::vector<std::string>();
+
+  const std::set<std::string>& words = dictionary->GetWords();
+  return std::vector<std::string>(words.begin(), words.end());
+}
+
+void SpellChecker::OnCustomDictionaryLoaded() {
+  SpellcheckCustomDictionary* dictionary = GetCustomDictionary();
+  if (dictionary)
+    dictionary->RemoveObserver(this);
+  observing_dictionary_ = false;
+
+  std::vector<base::Closure> tasks;
+  tasks.swap(pending_tasks_);
+  for (const auto& task : tasks)
+    task.Run();
+}
+
+void SpellChecker::OnCustomDictionaryChanged(
+    const SpellcheckCustomDictionary::Change& dictionary_change) {}
+
+SpellcheckCustomDictionary* SpellChecker::GetCustomDictionary() {
+  if (!browser_context_)
+    return nullptr;
+
+  SpellcheckService* spellcheck =
+    SpellcheckServiceFactory::GetForContext(browser_context_);
+  if (!spellcheck)
+    return nullptr;
+
+  return spellcheck->GetCustomDictionary();
+}
+
+void SpellChecker::RunWhenLoaded(const base::Closure& task) {
+  SpellcheckCustomDictionary* dictionary = GetCustomDictionary();
+  if (!dictionary || dictionary->IsLoaded()) {
+    task.Run();
+    return;
+  }
+
+  pending_tasks_.push_back(task);
+  if (!observing_dictionary_) {
+    dictionary->AddObserver(this);
+    observing_dictionary_ = true;
+  }
+}
+
+void SpellChecker::ReplaceWords(const std::set<std::string>& words) {
+  SpellcheckCustomDictionary* dictionary = GetCustomDictionary();
+  if (!dictionary)
+    return;
+
+  const std::set<std::string>& old_words = dictionary->GetWords();
+  std::set<std::string> to_add;
+  for (const auto& word : words) {
+    if (!old_words.count(word))
+      to_add.insert(word);
+  }
+  std::set<std::string> to_remove;
+  for (const auto& word : old_words) {
+    if (!words.count(word))
+      to_remove.insert(word);
+  }
+  ApplyChange(to_add, to_remove);
+}
+
+void SpellChecker::RunWordsCallback(const WordsCallback& callback) {
+  SpellcheckCustomDictionary* dictionary = GetCustomDictionary();
+  if (!dictionary) {
+    callback.Run(std::vector<std::string>());
+    return;
+  }
+
+  const std::set<std::string>& words = dictionary->GetWords();
+  callback.Run(std::vector<std::string>(words.begin(), words.end()));
+}
+
+void SpellChecker::ApplyChange(const std::set<std::string>& to_add,
+                               const std::set<std::string>& to_remove) {
+  if (to_add.empty() && to_remove.empty())
+    return;
+
+  SpellcheckCustomDictionary* dictionary = GetCustomDictionary();
+  if (!dictionary)
+    return;
+
+  // ProcessSyncChanges() is the only public entry point of the dictionary
+  // that sanitizes, saves and broadcasts a whole change set at once, unlike
+  // AddWord() and RemoveWord() which do all of that for every word.
+  syncer::SyncChangeList changes;
+  changes.reserve(to_add.size() + to_remove.size());
+  for (const auto& word : to_remove) {
+    if (!IsValidWord(word))
+      continue;
+    sync_pb::EntitySpecifics specifics;
+    specifics.mutable_dictionary()->set_word(word);
+    changes.push_back(syncer::SyncChange(
+        FROM_HERE, syncer::SyncChange::ACTION_DELETE,
+        syncer::SyncData::CreateLocalData(word, word, specifics)));
+  }
+  for (const auto& word : to_add) {
+    if (!IsValidWord(word))
+      continue;
+    sync_pb::EntitySpecifics specifics;
+    specifics.mutable_dictionary()->set_word(word);
+    changes.push_back(syncer::SyncChange(
+        FROM_HERE, syncer::SyncChange::ACTION_ADD,
+        syncer::SyncData::CreateLocalData(word, word, specifics)));
+  }
+  if (!changes.empty())
+    dictionary->ProcessSyncChanges(FROM_HERE, changes);
+}
+
 // static
 mate::Handle<SpellChecker> SpellChecker::Create(
     v8::Isolate* isolate,
@@ -80,7 +285,11 @@ void SpellChecker::BuildPrototype(v8::Isolate* isolate,
   prototype->SetClassName(mate::StringToV8(isolate, "SpellChecker"));
   mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
     .SetMethod("addWord", &SpellChecker::AddWord)
-    .SetMethod("removeWord", &SpellChecker::RemoveWord);
+    .SetMethod("removeWord", &SpellChecker::RemoveWord)
+    .SetMethod("addWords", &SpellChecker::AddWords)
+    .SetMethod("removeWords", &SpellChecker::RemoveWords)
+    .SetMethod("setWords", &SpellChecker::SetWords)
+    .SetMethod("getWords", &SpellChecker::GetWords);
 }
 
 }  // namespace api
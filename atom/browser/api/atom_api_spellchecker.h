@@ -5,16 +5,25 @@
 #ifndef ATOM_BROWSER_API_ATOM_API_SPELLCHECKER_H_
 #define ATOM_BROWSER_API_ATOM_API_SPELLCHECKER_H_
 
+#include <set>
+#include <string>
+#include <vector>
+
 #include "atom/browser/api/trackable_object.h"
+#include "base/callback.h"
 #include "brave/browser/brave_browser_context.h"
+#include "chrome/browser/spellchecker/spellcheck_custom_dictionary.h"
 #include "native_mate/handle.h"
 
 namespace atom {
 
 namespace api {
 
-class SpellChecker : public mate::TrackableObject<SpellChecker> {
+class SpellChecker : public mate::TrackableObject<SpellChecker>,
+                     public SpellcheckCustomDictionary::Observer {
  public:
+  using WordsCallback = base::Callback<void(const std::vector<std::string>&)>;
+
   static mate::Handle<SpellChecker> Create(v8::Isolate* isolate,
                                   content::BrowserContext* browser_context);
 
@@ -30,9 +39,41 @@ class SpellChecker : public mate::TrackableObject<SpellChecker> {
 
   void RemoveWord(mate::Arguments* args);
 
+  void AddWords(mate::Arguments* args);
+
+  void RemoveWords(mate::Arguments* args);
+
+  void SetWords(mate::Arguments* args);
+
+  std::vector<std::string> GetWords(mate::Arguments* args);
+
+  // SpellcheckCustomDictionary::Observer:
+  void OnCustomDictionaryLoaded() override;
+  void OnCustomDictionaryChanged(
+      const SpellcheckCustomDictionary::Change& dictionary_change) override;
+
  private:
+  SpellcheckCustomDictionary* GetCustomDictionary();
+
+  // Runs |task| now if the dictionary has loaded its file, otherwise once it
+  // has, in the order the tasks were queued. Changes made before the load
+  // would be diffed against an empty dictionary.
+  void RunWhenLoaded(const base::Closure& task);
+
+  void ReplaceWords(const std::set<std::string>& words);
+
+  void RunWordsCallback(const WordsCallback& callback);
+
+  // Applies the words as a single change to the custom dictionary, so the
+  // dictionary file is written and the renderers are updated only once.
+  void ApplyChange(const std::set<std::string>& to_add,
+                   const std::set<std::string>& to_remove);
+
   content::BrowserContext* browser_context_;  // not owned
 
+  std::vector<base::Closure> pending_tasks_;
+  bool observing_dictionary_;
+
   base::WeakPtrFactory<SpellChecker> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(SpellChecker);
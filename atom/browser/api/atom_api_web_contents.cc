@@ -2,10 +2,12 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "atom/browser/api/atom_api_web_contents.h"
 
@@ -42,6 +44,8 @@
 #include "atom/common/options_switches.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/brave_browser_context.h"
 #include "brave/browser/brave_content_browser_client.h"
 #include "brave/browser/guest_view/tab_view/tab_view_guest.h"
@@ -102,6 +106,8 @@
 #include "third_party/WebKit/public/web/WebFindOptions.h"
 #include "ui/base/l10n/l10n_util.h"
 #include "ui/display/screen.h"
+#include "ui/gfx/codec/jpeg_codec.h"
+#include "ui/gfx/codec/png_codec.h"
 
 #if !defined(OS_MACOSX)
 #include "ui/aura/window.h"
@@ -355,6 +361,34 @@ content::ServiceWorkerContext* GetServiceWorkerContext(
   return storage_partition->GetServiceWorkerContext();
 }
 
+std::unique_ptr<content::NavigationEntry> CreateRestoreEntry(
+    const mate::Dictionary& options) {
+  std::string url;
+  if (!options.Get("url", &url))
+    return nullptr;
+
+  std::unique_ptr<content::NavigationEntryImpl> entry =
+      base::WrapUnique(new content::NavigationEntryImpl);
+  entry->SetURL(GURL(url));
+  entry->SetVirtualURL(GURL(url));
+
+  std::string title;
+  if (options.Get("title", &title)) {
+    entry->SetTitle(base::UTF8ToUTF16(title));
+  }
+
+  std::string favicon_url;
+  if (options.Get("faviconUrl", &favicon_url) ||
+      options.Get("favIconUrl", &favicon_url)) {
+    content::FaviconStatus status;
+    status.valid = true;
+    status.url = GURL(favicon_url);
+    entry->GetFavicon() = status;
+  }
+
+  return std::move(entry);
+}
+
 // Called when CapturePage is done.
 void OnCapturePageDone(base::Callback<void(const gfx::Image&)> callback,
                        const SkBitmap& bitmap,
@@ -362,6 +396,97 @@ void OnCapturePageDone(base::Callback<void(const gfx::Image&)> callback,
   callback.Run(gfx::Image::CreateFrom1xBitmap(bitmap));
 }
 
+enum class CaptureFormat {
+  IMAGE,
+  BITMAP,
+  PNG,
+  JPEG,
+};
+
+using CapturePageCallback =
+    base::Callback<void(v8::Local<v8::Value>, const gfx::Size&)>;
+
+void FreeCaptureBuffer(char* data, void* hint) {
+  delete static_cast<std::vector<unsigned char>*>(hint);
+}
+
+// Runs on a worker thread so large captures don't block the UI thread.
+std::unique_ptr<std::vector<unsigned char>> EncodeCapture(
+    const SkBitmap& bitmap, CaptureFormat format, int quality) {
+  std::unique_ptr<std::vector<unsigned char>> output(
+      new std::vector<unsigned char>);
+  SkAutoLockPixels lock(bitmap);
+  switch (format) {
+    case CaptureFormat::PNG:
+      gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, output.get());
+      break;
+    case CaptureFormat::JPEG:
+      gfx::JPEGCodec::Encode(
+          reinterpret_cast<const unsigned char*>(bitmap.getPixels()),
+          gfx::JPEGCodec::FORMAT_SkBitmap, bitmap.width(), bitmap.height(),
+          static_cast<int>(bitmap.rowBytes()), quality, output.get());
+      break;
+    case CaptureFormat::BITMAP: {
+      SkImageInfo info = SkImageInfo::Make(bitmap.width(), bitmap.height(),
+          kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+      output->resize(info.minRowBytes() * info.height());
+      if (!bitmap.readPixels(info, output->data(), info.minRowBytes(), 0, 0))
+        output->clear();
+      break;
+    }
+    case CaptureFormat::IMAGE:
+      NOTREACHED();
+      break;
+  }
+  return output;
+}
+
+void OnCaptureEncoded(v8::Isolate* isolate,
+                      const CapturePageCallback& callback,
+                      const gfx::Size& size,
+                      std::unique_ptr<std::vector<unsigned char>> data) {
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+
+  if (!data || data->empty()) {
+    callback.Run(v8::Null(isolate), size);
+    return;
+  }
+
+  // hand the encoded data to the buffer without copying it
+  std::vector<unsigned char>* output = data.release();
+  callback.Run(node::Buffer::New(isolate,
+      reinterpret_cast<char*>(output->data()), output->size(),
+      &FreeCaptureBuffer, output).ToLocalChecked(), size);
+}
+
+void OnCapturePageWithOptionsDone(v8::Isolate* isolate,
+                                  CaptureFormat format,
+                                  int quality,
+                                  const CapturePageCallback& callback,
+                                  const SkBitmap& bitmap,
+                                  content::ReadbackResponse response) {
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+
+  gfx::Size size(bitmap.width(), bitmap.height());
+  if (response != content::READBACK_SUCCESS) {
+    callback.Run(v8::Null(isolate), gfx::Size());
+    return;
+  }
+
+  if (format == CaptureFormat::IMAGE) {
+    callback.Run(mate::ConvertToV8(isolate,
+        gfx::Image::CreateFrom1xBitmap(bitmap)), size);
+    return;
+  }
+
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::Bind(&EncodeCapture, bitmap, format, quality),
+      base::Bind(&OnCaptureEncoded, isolate, callback, size));
+}
+
 }  // namespace
 
 WebContents::WebContents(v8::Isolate* isolate,
@@ -726,6 +851,13 @@ void WebContents::IsPlaceholder(mate::Arguments* args) {
   args->Return(false);
 }
 
+v8::Local<v8::Value> WebContents::GetGuestTimings() {
+  auto guest = brave::TabViewGuest::FromWebContents(web_contents());
+  if (!guest)
+    return v8::Null(isolate());
+  return mate::ConvertToV8(isolate(), *guest->GetTimings());
+}
+
 void WebContents::AttachGuest(mate::Arguments* args) {
   auto tab_helper = extensions::TabHelper::FromWebContents(web_contents());
   if (tab_helper) {
@@ -2044,6 +2176,12 @@ void WebContents::Discard() {
   }
 }
 
+void WebContents::Prewarm() {
+  auto tab_helper = extensions::TabHelper::FromWebContents(web_contents());
+  if (tab_helper)
+    tab_helper->Prewarm();
+}
+
 #if BUILDFLAG(ENABLE_EXTENSIONS)
 bool WebContents::ExecuteScriptInTab(mate::Arguments* args) {
   auto tab_helper = extensions::TabHelper::FromWebContents(web_contents());
@@ -2052,6 +2190,14 @@ bool WebContents::ExecuteScriptInTab(mate::Arguments* args) {
 
   return tab_helper->ExecuteScriptInTab(args);
 }
+
+bool WebContents::ExecuteRegisteredScript(mate::Arguments* args) {
+  auto tab_helper = extensions::TabHelper::FromWebContents(web_contents());
+  if (!tab_helper)
+    return false;
+
+  return tab_helper->ExecuteRegisteredScript(args);
+}
 #endif
 
 bool WebContents::SendIPCSharedMemory(const base::string16& channel,
@@ -2067,6 +2213,8 @@ bool WebContents::SendIPCSharedMemory(const base::string16& channel,
 bool WebContents::SendIPCMessage(bool all_frames,
                                  const base::string16& channel,
                                  const base::ListValue& args) {
+  TRACE_EVENT1("electron.ipc", "WebContents::SendIPCMessage",
+               "channel", base::UTF16ToUTF8(channel));
   return Send(new AtomViewMsg_Message(routing_id(), all_frames, channel, args));
 }
 
@@ -2176,6 +2324,75 @@ void WebContents::CapturePage(mate::Arguments* args) {
       kBGRA_8888_SkColorType);
 }
 
+void WebContents::CapturePageWithOptions(const mate::Dictionary& options,
+                                         const CapturePageCallback& callback) {
+  const auto view = web_contents()->GetRenderWidgetHostView();
+  const auto host = view ? view->GetRenderWidgetHost() : nullptr;
+  if (!view || !host) {
+    callback.Run(v8::Null(isolate()), gfx::Size());
+    return;
+  }
+
+  gfx::Rect rect;
+  options.Get("rect", &rect);
+  const gfx::Size view_size = rect.IsEmpty() ? view->GetViewBounds().size() :
+                                               rect.size();
+  if (view_size.IsEmpty()) {
+    callback.Run(v8::Null(isolate()), gfx::Size());
+    return;
+  }
+
+  // Let the compositor scale to the requested size so we never read back
+  // more pixels than we need. If only one dimension is given the aspect
+  // ratio of the view is kept.
+  int width = 0;
+  int height = 0;
+  options.Get("width", &width);
+  options.Get("height", &height);
+  gfx::Size bitmap_size = view_size;
+  if (width > 0 && height > 0) {
+    bitmap_size = gfx::Size(width, height);
+  } else if (width > 0) {
+    bitmap_size = gfx::ScaleToCeiledSize(view_size,
+        static_cast<float>(width) / view_size.width());
+  } else if (height > 0) {
+    bitmap_size = gfx::ScaleToCeiledSize(view_size,
+        static_cast<float>(height) / view_size.height());
+  } else {
+    const float scale =
+        display::Screen::GetScreen()->GetDisplayNearestView(
+            view->GetNativeView()).device_scale_factor();
+    if (scale > 1.0f)
+      bitmap_size = gfx::ScaleToCeiledSize(view_size, scale);
+  }
+
+  CaptureFormat format = CaptureFormat::IMAGE;
+  std::string format_string;
+  if (options.Get("format", &format_string)) {
+    if (format_string == "bitmap") {
+      format = CaptureFormat::BITMAP;
+    } else if (format_string == "png") {
+      format = CaptureFormat::PNG;
+    } else if (format_string == "jpeg") {
+      format = CaptureFormat::JPEG;
+    } else if (format_string != "image") {
+      isolate()->ThrowException(v8::Exception::TypeError(mate::StringToV8(
+          isolate(), "Unsupported capture format " + format_string)));
+      return;
+    }
+  }
+
+  int quality = 90;
+  options.Get("quality", &quality);
+  quality = std::min(std::max(quality, 0), 100);
+
+  host->GetView()->CopyFromSurface(gfx::Rect(rect.origin(), view_size),
+      bitmap_size,
+      base::Bind(&OnCapturePageWithOptionsDone, isolate(), format, quality,
+                 callback),
+      kN32_SkColorType);
+}
+
 void WebContents::GetPreferredSize(mate::Arguments* args) {
   base::Callback<void(gfx::Size)> callback;
   if (!args->GetNext(&callback)) {
@@ -2405,6 +2622,8 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
                  &WebContents::ShowDefinitionForSelection)
       .SetMethod("copyImageAt", &WebContents::CopyImageAt)
       .SetMethod("capturePage", &WebContents::CapturePage)
+      .SetMethod("_capturePageWithOptions",
+                 &WebContents::CapturePageWithOptions)
       .SetMethod("getPreferredSize", &WebContents::GetPreferredSize)
       .SetProperty("id", &WebContents::ID)
       .SetProperty("attached", &WebContents::IsAttached)
@@ -2414,6 +2633,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("setPinned", &WebContents::SetPinned)
       .SetMethod("setTabIndex", &WebContents::SetTabIndex)
       .SetMethod("discard", &WebContents::Discard)
+      .SetMethod("prewarm", &WebContents::Prewarm)
       .SetMethod("setWebRTCIPHandlingPolicy",
                   &WebContents::SetWebRTCIPHandlingPolicy)
       .SetMethod("getWebRTCIPHandlingPolicy",
@@ -2434,6 +2654,8 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
                   &WebContents::AuthorizePlugin)
 #if BUILDFLAG(ENABLE_EXTENSIONS)
       .SetMethod("executeScriptInTab", &WebContents::ExecuteScriptInTab)
+      .SetMethod("executeRegisteredScript",
+                 &WebContents::ExecuteRegisteredScript)
       .SetMethod("isBackgroundPage", &WebContents::IsBackgroundPage)
       .SetMethod("tabValue", &WebContents::TabValue)
 #endif
@@ -2443,6 +2665,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("autofillPopupHidden", &WebContents::AutofillPopupHidden)
       .SetMethod("_attachGuest", &WebContents::AttachGuest)
       .SetMethod("_detachGuest", &WebContents::DetachGuest)
+      .SetMethod("getGuestTimings", &WebContents::GetGuestTimings)
       .SetMethod("isPlaceholder", &WebContents::IsPlaceholder)
       .SetMethod("savePassword", &WebContents::SavePassword)
       .SetMethod("neverSavePassword", &WebContents::NeverSavePassword)
@@ -2461,6 +2684,8 @@ AtomBrowserContext* WebContents::GetBrowserContext() const {
 
 void WebContents::OnRendererMessage(const base::string16& channel,
                                     const base::ListValue& args) {
+  TRACE_EVENT1("electron.ipc", "WebContents::OnRendererMessage",
+               "channel", base::UTF16ToUTF8(channel));
   // webContents.emit(channel, new Event(), args...);
   Emit(base::UTF16ToUTF8(channel), args);
 }
@@ -2468,6 +2693,8 @@ void WebContents::OnRendererMessage(const base::string16& channel,
 void WebContents::OnRendererMessageSync(const base::string16& channel,
                                         const base::ListValue& args,
                                         IPC::Message* message) {
+  TRACE_EVENT1("electron.ipc", "WebContents::OnRendererMessageSync",
+               "channel", base::UTF16ToUTF8(channel));
   // webContents.emit(channel, new Event(sender, message), args...);
   EmitWithSender(base::UTF16ToUTF8(channel), web_contents(), message, args);
 }
@@ -2523,34 +2750,36 @@ void WebContents::OnTabCreated(const mate::Dictionary& options,
 
   bool discarded = false;
   if (options.Get("discarded", &discarded) && discarded && !active) {
-    std::string url;
-    if (options.Get("url", &url)) {
-      std::unique_ptr<content::NavigationEntryImpl> entry =
-          base::WrapUnique(new content::NavigationEntryImpl);
-      entry->SetURL(GURL(url));
-      entry->SetVirtualURL(GURL(url));
-
-      std::string title;
-      if (options.Get("title", &title)) {
-        entry->SetTitle(base::UTF8ToUTF16(title));
-      }
-
-      std::string favicon_url;
-      if (options.Get("faviconUrl", &favicon_url) ||
-          options.Get("favIconUrl", &favicon_url)) {
-        content::FaviconStatus status;
-        status.valid = true;
-        status.url = GURL(favicon_url);
-        entry->GetFavicon() = status;
+    // Restore the navigation history without loading anything. The renderer
+    // is only started when the tab is activated or prewarmed.
+    std::vector<std::unique_ptr<content::NavigationEntry>> entries;
+    std::vector<mate::Dictionary> navigation_history;
+    if (options.Get("navigationHistory", &navigation_history)) {
+      for (const auto& entry_options : navigation_history) {
+        auto entry = CreateRestoreEntry(entry_options);
+        if (entry)
+          entries.push_back(std::move(entry));
       }
+    } else {
+      auto entry = CreateRestoreEntry(options);
+      if (entry)
+        entries.push_back(std::move(entry));
+    }
 
-      std::vector<std::unique_ptr<content::NavigationEntry>> entries;
-      entries.push_back(std::move(entry));
-      tab->GetController().Restore(entries.size() - 1,
+    if (!entries.empty()) {
+      int current_index = entries.size() - 1;
+      if (options.Get("currentEntryIndex", &current_index))
+        current_index = std::min(std::max(current_index, 0),
+                                 static_cast<int>(entries.size()) - 1);
+      tab->GetController().Restore(current_index,
           content::RestoreType::CURRENT_SESSION, &entries);
     }
 
     tab_helper->Discard();
+
+    bool prewarm = false;
+    if (options.Get("prewarm", &prewarm) && prewarm)
+      tab_helper->Prewarm();
   }
 
   int windowId = -1;
@@ -2705,6 +2934,10 @@ void Initialize(v8::Local<v8::Object> exports, v8::Local<v8::Value> unused,
   dict.SetMethod("fromId", &mate::TrackableObject<WebContents>::FromWeakMapID);
   dict.SetMethod("getAllWebContents",
                  &mate::TrackableObject<WebContents>::GetAll);
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+  dict.SetMethod("registerScript", &extensions::TabHelper::RegisterScript);
+  dict.SetMethod("unregisterScript", &extensions::TabHelper::UnregisterScript);
+#endif
 }
 
 }  // namespace
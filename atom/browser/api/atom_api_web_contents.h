@@ -238,6 +238,7 @@ class WebContents : public mate::TrackableObject<WebContents>,
   void SetPinned(bool pinned);
   void SetAutoDiscardable(bool auto_discardable);
   void Discard();
+  void Prewarm();
 
   // Zoom
   void SetZoomLevel(double zoom);
@@ -248,6 +249,7 @@ class WebContents : public mate::TrackableObject<WebContents>,
 
 #if BUILDFLAG(ENABLE_EXTENSIONS)
   bool ExecuteScriptInTab(mate::Arguments* args);
+  bool ExecuteRegisteredScript(mate::Arguments* args);
   void SetTabValues(const base::DictionaryValue& values);
 #endif
 
@@ -268,6 +270,13 @@ class WebContents : public mate::TrackableObject<WebContents>,
   // done.
   void CapturePage(mate::Arguments* args);
 
+  // Captures the page scaled to the requested size and encodes it to the
+  // requested format off the UI thread.
+  void CapturePageWithOptions(
+      const mate::Dictionary& options,
+      const base::Callback<void(v8::Local<v8::Value>,
+                                const gfx::Size&)>& callback);
+
   void EnablePreferredSizeMode(bool enable);
   void GetPreferredSize(mate::Arguments* args);
 
@@ -286,6 +295,7 @@ class WebContents : public mate::TrackableObject<WebContents>,
   void AttachGuest(mate::Arguments* args);
   void DetachGuest(mate::Arguments* args);
   void IsPlaceholder(mate::Arguments* args);
+  v8::Local<v8::Value> GetGuestTimings();
 
   void SavePassword();
   void NeverSavePassword();
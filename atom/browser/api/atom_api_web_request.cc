@@ -4,17 +4,24 @@
 
 #include "atom/browser/api/atom_api_web_request.h"
 
+#include <algorithm>
+
 #include "atom/browser/net/atom_network_delegate.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
 #include "atom/common/native_mate_converters/net_converter.h"
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
 #include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_thread.h"
 #include "extensions/features/features.h"
 #include "native_mate/dictionary.h"
 #include "native_mate/object_template_builder.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/url_request/url_fetcher_response_writer.h"
 #include "net/url_request/url_request_context.h"
 #include "v8/include/v8.h"
 
@@ -22,6 +29,8 @@
 #include "extensions/browser/api/web_request/web_request_api_helpers.h"
 #endif
 
+#include "atom/common/node_includes.h"
+
 using content::BrowserThread;
 
 namespace mate {
@@ -58,32 +67,190 @@ struct Converter<net::URLFetcher::RequestType> {
   }
 };
 
+template<>
+struct Converter<atom::api::WebRequest::FetchPriority> {
+  static bool FromV8(v8::Isolate* isolate, v8::Handle<v8::Value> val,
+                     atom::api::WebRequest::FetchPriority* out) {
+    std::string priority;
+    if (!ConvertFromV8(isolate, val, &priority))
+      return false;
+    if (priority == "high")
+      *out = atom::api::WebRequest::FetchPriority::HIGH;
+    else if (priority == "normal")
+      *out = atom::api::WebRequest::FetchPriority::NORMAL;
+    else if (priority == "low")
+      *out = atom::api::WebRequest::FetchPriority::LOW;
+    else
+      return false;
+    return true;
+  }
+};
+
 }  // namespace mate
 
 namespace atom {
 
 namespace api {
 
+namespace {
+
+// Number of fetches that run at the same time unless changed with
+// setFetchConcurrency.
+const int kDefaultMaxActiveFetches = 6;
+
+// Bytes of a streamed body that can wait in UI thread before the network
+// read is paused.
+const int kMaxPendingStreamBytes = 1024 * 1024;
+
+void FreeBody(char* data, void* hint) {
+  delete static_cast<std::string*>(hint);
+}
+
+// Hands a string to a Buffer without copying it.
+v8::Local<v8::Value> ToBuffer(v8::Isolate* isolate,
+                              std::unique_ptr<std::string> data) {
+  std::string* output = data.release();
+  return node::Buffer::New(isolate,
+                           const_cast<char*>(output->data()),
+                           output->size(),
+                           &FreeBody,
+                           output).ToLocalChecked();
+}
+
+// Shared by a StreamResponseWriter in IO thread and the chunks it has posted
+// to UI thread, pauses the network read while too many bytes are pending.
+class StreamState : public base::RefCountedThreadSafe<StreamState> {
+ public:
+  StreamState() : pending_bytes_(0), paused_bytes_(0) {}
+
+  // Returns false when the write has to wait for OnConsumed.
+  bool OnWrite(int num_bytes, const net::CompletionCallback& callback) {
+    base::AutoLock auto_lock(lock_);
+    pending_bytes_ += num_bytes;
+    if (pending_bytes_ <= kMaxPendingStreamBytes)
+      return true;
+    paused_bytes_ = num_bytes;
+    paused_callback_ = callback;
+    return false;
+  }
+
+  // Called in IO thread after UI thread has handled |num_bytes|.
+  void OnConsumed(int num_bytes) {
+    net::CompletionCallback callback;
+    int paused_bytes;
+    {
+      base::AutoLock auto_lock(lock_);
+      pending_bytes_ -= num_bytes;
+      if (paused_callback_.is_null() ||
+          pending_bytes_ > kMaxPendingStreamBytes)
+        return;
+      callback = paused_callback_;
+      paused_callback_.Reset();
+      paused_bytes = paused_bytes_;
+    }
+    callback.Run(paused_bytes);
+  }
+
+  // The writer is gone, so its callback must not be run.
+  void Detach() {
+    base::AutoLock auto_lock(lock_);
+    paused_callback_.Reset();
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<StreamState>;
+  ~StreamState() {}
+
+  base::Lock lock_;
+  int pending_bytes_;
+  int paused_bytes_;
+  net::CompletionCallback paused_callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamState);
+};
+
+// Forwards the response body to UI thread chunk by chunk instead of keeping
+// it in memory.
+class StreamResponseWriter : public net::URLFetcherResponseWriter {
+ public:
+  StreamResponseWriter(
+      const base::Callback<void(std::unique_ptr<std::string>)>& on_data)
+      : on_data_(on_data), state_(new StreamState) {}
+
+  ~StreamResponseWriter() override {
+    state_->Detach();
+  }
+
+  // net::URLFetcherResponseWriter:
+  int Initialize(const net::CompletionCallback& callback) override {
+    return net::OK;
+  }
+
+  int Write(net::IOBuffer* buffer,
+            int num_bytes,
+            const net::CompletionCallback& callback) override {
+    std::unique_ptr<std::string> chunk(
+        new std::string(buffer->data(), num_bytes));
+    BrowserThread::PostTaskAndReply(
+        BrowserThread::UI, FROM_HERE,
+        base::Bind(on_data_, base::Passed(&chunk)),
+        base::Bind(&StreamState::OnConsumed, state_, num_bytes));
+    return state_->OnWrite(num_bytes, callback) ? num_bytes
+                                                : net::ERR_IO_PENDING;
+  }
+
+  int Finish(int net_error, const net::CompletionCallback& callback) override {
+    return net::OK;
+  }
+
+ private:
+  base::Callback<void(std::unique_ptr<std::string>)> on_data_;
+  scoped_refptr<StreamState> state_;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamResponseWriter);
+};
+
+}  // namespace
+
+struct WebRequest::FetchJob {
+  std::unique_ptr<net::URLFetcher> fetcher;
+  FetchPriority priority;
+  FetchCallback callback;
+  FetchDataCallback on_data;
+  FetchProgressCallback on_progress;
+  bool binary;
+};
+
 WebRequest::WebRequest(v8::Isolate* isolate,
                        Profile* profile)
-    : profile_(profile) {
+    : profile_(profile),
+      max_active_fetches_(kDefaultMaxActiveFetches),
+      next_fetch_id_(1),
+      weak_factory_(this) {
   Init(isolate);
 }
 
 WebRequest::~WebRequest() {
-  fetchers_.clear();
 }
 
 void WebRequest::OnURLFetchComplete(
     const net::URLFetcher* source) {
-  FetchCallback callback = fetchers_[source];
-  fetchers_.erase(source);
+  auto active = active_fetches_.find(source);
+  if (active == active_fetches_.end())
+    return;
+  int id = active->second;
+  active_fetches_.erase(active);
+  std::unique_ptr<FetchJob> job = std::move(fetch_jobs_[id]);
+  fetch_jobs_.erase(id);
+
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
 
   mate::Dictionary response = mate::Dictionary::CreateEmpty(isolate());
   int response_code = source->GetResponseCode();
   response.Set("statusCode", response_code);
 
-  std::string body;
+  std::unique_ptr<std::string> body(new std::string);
   v8::Local<v8::Value> err = v8::Null(isolate());
   if (response_code == net::URLFetcher::ResponseCode::RESPONSE_CODE_INVALID ||
       !source->GetStatus().is_success()) {
@@ -93,20 +260,105 @@ void WebRequest::OnURLFetchComplete(
   } else {
     const net::HttpResponseHeaders* headers = source->GetResponseHeaders();
     response.Set("headers", headers);
-    source->GetResponseAsString(&body);
+    if (job->on_data.is_null())
+      source->GetResponseAsString(body.get());
   }
 
   // error, response, body
-  const uint8_t* data = reinterpret_cast<const uint8_t*>(body.c_str());
-  callback.Run(err, response, v8::String::NewFromOneByte(isolate(),
-      data, v8::NewStringType::kNormal, body.length()).ToLocalChecked());
+  v8::Local<v8::Value> result;
+  if (job->binary) {
+    result = ToBuffer(isolate(), std::move(body));
+  } else {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(body->c_str());
+    result = v8::String::NewFromOneByte(isolate(),
+        data, v8::NewStringType::kNormal, body->length()).ToLocalChecked();
+  }
+  job->callback.Run(err, response, result);
+
+  StartQueuedFetches();
+}
+
+void WebRequest::OnURLFetchDownloadProgress(const net::URLFetcher* source,
+                                            int64_t current,
+                                            int64_t total,
+                                            int64_t current_network_bytes) {
+  auto active = active_fetches_.find(source);
+  if (active == active_fetches_.end())
+    return;
+  // The handler may cancel the fetch, which destroys the job.
+  FetchProgressCallback on_progress =
+      fetch_jobs_[active->second]->on_progress;
+  if (on_progress.is_null())
+    return;
+
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  on_progress.Run(current, total);
+}
+
+void WebRequest::OnFetchData(int id, std::unique_ptr<std::string> chunk) {
+  auto it = fetch_jobs_.find(id);
+  if (it == fetch_jobs_.end())
+    return;
+
+  // The handler may cancel the fetch, which destroys the job.
+  FetchDataCallback on_data = it->second->on_data;
+
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  on_data.Run(ToBuffer(isolate(), std::move(chunk)));
 }
 
-void WebRequest::Fetch(mate::Arguments* args) {
+void WebRequest::StartQueuedFetches() {
+  while (!queued_fetches_.empty() &&
+         static_cast<int>(active_fetches_.size()) < max_active_fetches_) {
+    int id = queued_fetches_.begin()->second;
+    queued_fetches_.erase(queued_fetches_.begin());
+
+    net::URLFetcher* fetcher = fetch_jobs_[id]->fetcher.get();
+    active_fetches_[fetcher] = id;
+    fetcher->Start();
+  }
+}
+
+void WebRequest::CancelFetch(int id) {
+  auto it = fetch_jobs_.find(id);
+  if (it == fetch_jobs_.end())
+    return;
+
+  std::unique_ptr<FetchJob> job = std::move(it->second);
+  fetch_jobs_.erase(it);
+  // Deleting the fetcher cancels the request.
+  active_fetches_.erase(job->fetcher.get());
+  for (auto queued = queued_fetches_.begin();
+       queued != queued_fetches_.end(); ++queued) {
+    if (queued->second == id) {
+      queued_fetches_.erase(queued);
+      break;
+    }
+  }
+
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  base::DictionaryValue dict;
+  dict.SetInteger("errorCode", net::ERR_ABORTED);
+  mate::Dictionary response = mate::Dictionary::CreateEmpty(isolate());
+  job->callback.Run(mate::ConvertToV8(isolate(), dict), response,
+                    v8::Null(isolate()));
+
+  StartQueuedFetches();
+}
+
+void WebRequest::SetFetchConcurrency(int max_active_fetches) {
+  max_active_fetches_ = std::max(1, max_active_fetches);
+  StartQueuedFetches();
+}
+
+int WebRequest::Fetch(mate::Arguments* args) {
   GURL url;
   if (!args->GetNext(&url) || !url.is_valid()) {
     args->ThrowError("invalid url parameter");
-    return;
+    return -1;
   }
 
   net::URLFetcher::RequestType request_type = net::URLFetcher::RequestType::GET;
@@ -114,6 +366,9 @@ void WebRequest::Fetch(mate::Arguments* args) {
   base::FilePath path;
   std::string payload;
   std::string payload_content_type;
+  std::unique_ptr<FetchJob> job(new FetchJob);
+  job->priority = FetchPriority::NORMAL;
+  job->binary = false;
   mate::Dictionary dict;
   if (args->GetNext(&dict)) {
     dict.Get("method", &request_type);
@@ -124,27 +379,41 @@ void WebRequest::Fetch(mate::Arguments* args) {
         args->ThrowError("payload_content_type is required for payload");
       }
     }
+    dict.Get("priority", &job->priority);
+    dict.Get("binary", &job->binary);
+    dict.Get("onData", &job->on_data);
+    dict.Get("onProgress", &job->on_progress);
   }
 
-  FetchCallback callback;
-  if (!args->GetNext(&callback)) {
+  if (!args->GetNext(&job->callback)) {
     args->ThrowError("invalid callback parameter");
-    return;
+    return -1;
   }
 
-  net::URLFetcher* fetcher = net::URLFetcher::Create(url, request_type, this)
-      .release();
+  int id = next_fetch_id_++;
+  job->fetcher = net::URLFetcher::Create(url, request_type, this);
+  net::URLFetcher* fetcher = job->fetcher.get();
   fetcher->SetRequestContext(profile_->GetRequestContext());
   if (!payload.empty())
     fetcher->SetUploadData(payload_content_type, payload);
   if (!headers.IsEmpty())
     fetcher->SetExtraRequestHeaders(headers.ToString());
-  if (!path.empty())
+  if (!path.empty()) {
     fetcher->SaveResponseToFileAtPath(
         path,
         BrowserThread::GetTaskRunnerForThread(BrowserThread::FILE));
-  fetcher->Start();
-  fetchers_[fetcher] = FetchCallback(callback);
+  } else if (!job->on_data.is_null()) {
+    fetcher->SaveResponseWithWriter(
+        std::unique_ptr<net::URLFetcherResponseWriter>(
+            new StreamResponseWriter(
+                base::Bind(&WebRequest::OnFetchData,
+                           weak_factory_.GetWeakPtr(), id))));
+  }
+
+  queued_fetches_.insert(std::make_pair(job->priority, id));
+  fetch_jobs_[id] = std::move(job);
+  StartQueuedFetches();
+  return id;
 }
 
 template<AtomNetworkDelegate::SimpleEvent type>
@@ -241,7 +510,11 @@ void WebRequest::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("handleBehaviorChanged",
                  &WebRequest::HandleBehaviorChanged)
       .SetMethod("fetch",
-                 &WebRequest::Fetch);
+                 &WebRequest::Fetch)
+      .SetMethod("cancelFetch",
+                 &WebRequest::CancelFetch)
+      .SetMethod("setFetchConcurrency",
+                 &WebRequest::SetFetchConcurrency);
 }
 
 }  // namespace api
@@ -13,6 +13,7 @@
 #include "atom/browser/api/trackable_object.h"
 #include "atom/browser/net/atom_network_delegate.h"
 #include "atom/common/native_mate_converters/value_converter.h"
+#include "base/memory/weak_ptr.h"
 #include "base/strings/string_util.h"
 #include "native_mate/arguments.h"
 #include "native_mate/handle.h"
@@ -49,10 +50,27 @@ class WebRequest : public mate::TrackableObject<WebRequest>,
   typedef base::Callback<void(
       v8::Local<v8::Value>,
       const mate::Dictionary&,
-      v8::Local<v8::String>)> FetchCallback;
+      v8::Local<v8::Value>)> FetchCallback;
+  typedef base::Callback<void(v8::Local<v8::Value>)> FetchDataCallback;
+  typedef base::Callback<void(double, double)> FetchProgressCallback;
+
+  enum class FetchPriority {
+    HIGH,
+    NORMAL,
+    LOW,
+  };
+
   void HandleBehaviorChanged();
-  void Fetch(mate::Arguments* args);
+  int Fetch(mate::Arguments* args);
+  void CancelFetch(int id);
+  void SetFetchConcurrency(int max_active_fetches);
+
+  // net::URLFetcherDelegate:
   void OnURLFetchComplete(const net::URLFetcher* source) override;
+  void OnURLFetchDownloadProgress(const net::URLFetcher* source,
+                                  int64_t current,
+                                  int64_t total,
+                                  int64_t current_network_bytes) override;
 
   // C++ can not distinguish overloaded member function.
   template<AtomNetworkDelegate::SimpleEvent type>
@@ -68,8 +86,26 @@ class WebRequest : public mate::TrackableObject<WebRequest>,
   void SetListener(Method method, Event type, mate::Arguments* args);
 
  private:
+  struct FetchJob;
+
+  // Starts queued fetches, highest priority first, until the concurrency
+  // limit is reached.
+  void StartQueuedFetches();
+  // Called in UI thread with each chunk of a streamed response body.
+  void OnFetchData(int id, std::unique_ptr<std::string> chunk);
+
   Profile* profile_;
-  std::map<const net::URLFetcher*, FetchCallback> fetchers_;
+
+  // All the fetches, queued or running, keyed by id.
+  std::map<int, std::unique_ptr<FetchJob>> fetch_jobs_;
+  // Queued fetch ids, in start order.
+  std::multimap<FetchPriority, int> queued_fetches_;
+  // Running fetch ids, keyed by fetcher.
+  std::map<const net::URLFetcher*, int> active_fetches_;
+  int max_active_fetches_;
+  int next_fetch_id_;
+
+  base::WeakPtrFactory<WebRequest> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(WebRequest);
 };
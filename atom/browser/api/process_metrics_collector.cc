@@ -0,0 +1,223 @@
+// Copyright (c) 2017 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/api/process_metrics_collector.h"
+
+#include <utility>
+
+#include "atom/browser/api/atom_api_web_contents.h"
+#include "atom/browser/extensions/tab_helper.h"
+#include "atom/browser/javascript_environment.h"
+#include "base/bind.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/threading/platform_thread.h"
+#include "brave/common/workers/v8_worker_thread.h"
+#include "content/child/worker_thread_registry.h"
+#include "content/public/browser/browser_child_process_host.h"
+#include "content/public/browser/browser_child_process_host_iterator.h"
+#include "content/public/browser/child_process_data.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/render_view_host.h"
+#include "content/public/browser/render_widget_host.h"
+#include "content/public/browser/render_widget_host_iterator.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/common/process_type.h"
+
+using content::BrowserThread;
+
+namespace atom {
+
+namespace api {
+
+namespace {
+
+std::string ChildProcessTypeToString(int process_type) {
+  switch (process_type) {
+    case content::PROCESS_TYPE_GPU:
+      return "gpu";
+    case content::PROCESS_TYPE_UTILITY:
+      return "utility";
+    case content::PROCESS_TYPE_PPAPI_PLUGIN:
+      return "plugin";
+    case content::PROCESS_TYPE_PPAPI_BROKER:
+      return "broker";
+    default:
+      return "unknown";
+  }
+}
+
+}  // namespace
+
+ProcessMetricsCollector::ProcessInfo::ProcessInfo() : pid(0) {
+}
+
+ProcessMetricsCollector::ProcessInfo::ProcessInfo(
+    const ProcessInfo& other) = default;
+
+ProcessMetricsCollector::ProcessInfo::~ProcessInfo() {
+}
+
+ProcessMetricsCollector::ProcessMetricsCollector(const Callback& callback)
+    : callback_(callback) {
+}
+
+ProcessMetricsCollector::~ProcessMetricsCollector() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  callback_.Run(this);
+}
+
+void ProcessMetricsCollector::Start(v8::Isolate* isolate) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+
+  ProcessInfo browser;
+  browser.pid = base::GetCurrentProcId();
+  browser.type = "browser";
+  {
+    base::AutoLock auto_lock(lock_);
+    processes_.push_back(browser);
+  }
+  AddIsolate("main", base::PlatformThread::CurrentId(), isolate);
+
+  CollectRenderProcesses();
+
+  // The tasks hold references to this, so the callback runs after the last
+  // of them has run or has been dropped by a thread that is shutting down.
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::Bind(&ProcessMetricsCollector::CollectChildProcessesOnIO, this));
+  content::WorkerThreadRegistry::Instance()->PostTaskToAllThreads(
+      base::Bind(&ProcessMetricsCollector::CollectWorkerIsolate, this));
+}
+
+void ProcessMetricsCollector::CollectRenderProcesses() {
+  std::map<int, ProcessInfo> renderers;
+  for (content::RenderProcessHost::iterator it(
+          content::RenderProcessHost::AllHostsIterator());
+       !it.IsAtEnd(); it.Advance()) {
+    content::RenderProcessHost* host = it.GetCurrentValue();
+    if (!host->HasConnection() ||
+        host->GetHandle() == base::kNullProcessHandle)
+      continue;
+    ProcessInfo& info = renderers[host->GetID()];
+    info.pid = base::GetProcId(host->GetHandle());
+    info.type = "renderer";
+  }
+
+  std::unique_ptr<content::RenderWidgetHostIterator> widgets(
+      content::RenderWidgetHost::GetRenderWidgetHosts());
+  while (content::RenderWidgetHost* widget = widgets->GetNextHost()) {
+    auto it = renderers.find(widget->GetProcess()->GetID());
+    if (it == renderers.end())
+      continue;
+    content::RenderViewHost* rvh = content::RenderViewHost::From(widget);
+    if (!rvh)
+      continue;
+    content::WebContents* web_contents =
+        content::WebContents::FromRenderViewHost(rvh);
+    if (!web_contents)
+      continue;
+
+    int32_t id = WebContents::GetIDFromWrappedClass(web_contents);
+    if (id)
+      it->second.web_contents_ids.insert(id);
+    int32_t tab_id = extensions::TabHelper::IdForTab(web_contents);
+    if (tab_id != -1)
+      it->second.tab_ids.insert(tab_id);
+  }
+
+  base::AutoLock auto_lock(lock_);
+  for (const auto& renderer : renderers)
+    processes_.push_back(renderer.second);
+}
+
+void ProcessMetricsCollector::CollectChildProcessesOnIO() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+
+  std::vector<ProcessInfo> children;
+  for (content::BrowserChildProcessHostIterator it; !it.Done(); ++it) {
+    const content::ChildProcessData& data = it.GetData();
+    if (data.handle == base::kNullProcessHandle)
+      continue;
+    ProcessInfo info;
+    info.pid = base::GetProcId(data.handle);
+    info.type = ChildProcessTypeToString(data.process_type);
+    info.name = base::UTF16ToUTF8(data.name);
+    children.push_back(info);
+  }
+
+  base::AutoLock auto_lock(lock_);
+  processes_.insert(processes_.end(), children.begin(), children.end());
+}
+
+void ProcessMetricsCollector::CollectWorkerIsolate() {
+  brave::V8WorkerThread* worker = brave::V8WorkerThread::current();
+  if (!worker || !worker->env())
+    return;
+  AddIsolate(worker->thread_name(), worker->GetThreadId(),
+             worker->env()->isolate());
+}
+
+void ProcessMetricsCollector::AddIsolate(const std::string& name,
+                                         int thread_id,
+                                         v8::Isolate* isolate) {
+  v8::HeapStatistics heap_statistics;
+  isolate->GetHeapStatistics(&heap_statistics);
+
+  IsolateInfo info;
+  info.name = name;
+  info.thread_id = thread_id;
+  info.used_heap_size = heap_statistics.used_heap_size();
+  info.total_heap_size = heap_statistics.total_heap_size();
+  info.heap_size_limit = heap_statistics.heap_size_limit();
+
+  base::AutoLock auto_lock(lock_);
+  isolates_.push_back(info);
+}
+
+ProcessMetricsCache::ProcessMetricsCache() {
+}
+
+ProcessMetricsCache::~ProcessMetricsCache() {
+}
+
+ProcessMetricsCache::Entry* ProcessMetricsCache::Get(base::ProcessId pid) {
+  auto it = entries_.find(pid);
+  if (it != entries_.end())
+    return it->second.get();
+
+  std::unique_ptr<Entry> entry(new Entry);
+  if (pid == base::GetCurrentProcId()) {
+    entry->process = base::Process::Current();
+    entry->metrics = base::ProcessMetrics::CreateCurrentProcessMetrics();
+  } else {
+    entry->process = base::Process::Open(pid);
+    if (!entry->process.IsValid())
+      return nullptr;
+#if defined(OS_MACOSX)
+    entry->metrics = base::ProcessMetrics::CreateProcessMetrics(
+        entry->process.Handle(),
+        content::BrowserChildProcessHost::GetPortProvider());
+#else
+    entry->metrics =
+        base::ProcessMetrics::CreateProcessMetrics(entry->process.Handle());
+#endif
+  }
+
+  Entry* result = entry.get();
+  entries_[pid] = std::move(entry);
+  return result;
+}
+
+void ProcessMetricsCache::Prune(const std::set<base::ProcessId>& pids) {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (pids.count(it->first))
+      ++it;
+    else
+      it = entries_.erase(it);
+  }
+}
+
+}  // namespace api
+
+}  // namespace atom
@@ -0,0 +1,115 @@
+// Copyright (c) 2017 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_API_PROCESS_METRICS_COLLECTOR_H_
+#define ATOM_BROWSER_API_PROCESS_METRICS_COLLECTOR_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/ref_counted.h"
+#include "base/process/process.h"
+#include "base/process/process_metrics.h"
+#include "base/synchronization/lock.h"
+#include "content/public/browser/browser_thread.h"
+#include "v8/include/v8.h"
+
+namespace atom {
+
+namespace api {
+
+// Finds the processes of the app and the V8 isolates of the browser process.
+// Each thread that owns some of them adds what it knows, and the callback is
+// run in UI thread once the last thread is done with the collector.
+class ProcessMetricsCollector
+    : public base::RefCountedThreadSafe<
+          ProcessMetricsCollector,
+          content::BrowserThread::DeleteOnUIThread> {
+ public:
+  struct ProcessInfo {
+    ProcessInfo();
+    ProcessInfo(const ProcessInfo& other);
+    ~ProcessInfo();
+
+    base::ProcessId pid;
+    std::string type;
+    std::string name;
+    std::set<int32_t> web_contents_ids;
+    std::set<int32_t> tab_ids;
+  };
+
+  struct IsolateInfo {
+    std::string name;
+    int thread_id;
+    size_t used_heap_size;
+    size_t total_heap_size;
+    size_t heap_size_limit;
+  };
+
+  using Callback = base::Callback<void(const ProcessMetricsCollector*)>;
+
+  explicit ProcessMetricsCollector(const Callback& callback);
+
+  // Must be called in UI thread, |isolate| is the main isolate of the browser
+  // process.
+  void Start(v8::Isolate* isolate);
+
+  // Only safe to use from the callback.
+  const std::vector<ProcessInfo>& processes() const { return processes_; }
+  const std::vector<IsolateInfo>& isolates() const { return isolates_; }
+
+ private:
+  friend struct content::BrowserThread::DeleteOnThread<
+      content::BrowserThread::UI>;
+  friend class base::DeleteHelper<ProcessMetricsCollector>;
+  ~ProcessMetricsCollector();
+
+  void CollectRenderProcesses();
+  void CollectChildProcessesOnIO();
+  void CollectWorkerIsolate();
+  void AddIsolate(const std::string& name, int thread_id,
+                  v8::Isolate* isolate);
+
+  Callback callback_;
+
+  base::Lock lock_;
+  std::vector<ProcessInfo> processes_;
+  std::vector<IsolateInfo> isolates_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProcessMetricsCollector);
+};
+
+// Keeps a base::ProcessMetrics for each process between snapshots, the CPU
+// usage of a snapshot is measured since the previous one.
+class ProcessMetricsCache {
+ public:
+  struct Entry {
+    base::Process process;
+    std::unique_ptr<base::ProcessMetrics> metrics;
+  };
+
+  ProcessMetricsCache();
+  ~ProcessMetricsCache();
+
+  // Returns null when the process can not be opened.
+  Entry* Get(base::ProcessId pid);
+
+  // Forgets the processes that are not in |pids|.
+  void Prune(const std::set<base::ProcessId>& pids);
+
+ private:
+  std::map<base::ProcessId, std::unique_ptr<Entry>> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProcessMetricsCache);
+};
+
+}  // namespace api
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_API_PROCESS_METRICS_COLLECTOR_H_
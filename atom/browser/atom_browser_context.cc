@@ -66,6 +66,20 @@ AtomBrowserContext::AtomBrowserContext(
   use_cache_ = true;
   options.GetBoolean("cache", &use_cache_);
 
+  cache_backend_type_ = net::CACHE_BACKEND_DEFAULT;
+  std::string cache_type;
+  if (options.GetString("cacheType", &cache_type)) {
+    if (cache_type == "simple")
+      cache_backend_type_ = net::CACHE_BACKEND_SIMPLE;
+    else if (cache_type == "blockfile")
+      cache_backend_type_ = net::CACHE_BACKEND_BLOCKFILE;
+  }
+  // 0 lets the backend pick a size based on the available disk space.
+  cache_max_size_ = 0;
+  options.GetInteger("cacheMaxSize", &cache_max_size_);
+  cache_memory_only_ = false;
+  options.GetBoolean("cacheMemoryOnly", &cache_memory_only_);
+
   // Initialize Pref Registry in brightray.
   // InitPrefs();
 }
@@ -119,12 +133,20 @@ AtomBrowserContext::CreateURLRequestJobFactory(
 
 net::HttpCache::BackendFactory*
 AtomBrowserContext::CreateHttpCacheBackendFactory(
-    const base::FilePath& base_path) {
+    const base::FilePath& base_path, bool in_memory) {
   base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
   if (!use_cache_ || command_line->HasSwitch(switches::kDisableHttpCache))
     return new NoCacheBackend;
-  else
-    return brightray::BrowserContext::CreateHttpCacheBackendFactory(base_path);
+
+  if (in_memory || cache_memory_only_)
+    return net::HttpCache::DefaultBackend::InMemory(cache_max_size_).release();
+
+  return new net::HttpCache::DefaultBackend(
+      net::DISK_CACHE,
+      cache_backend_type_,
+      base_path.Append(FILE_PATH_LITERAL("Cache")),
+      cache_max_size_,
+      BrowserThread::GetTaskRunnerForThread(BrowserThread::CACHE));
 }
 
 content::DownloadManagerDelegate*
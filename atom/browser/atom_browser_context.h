@@ -31,7 +31,7 @@ class AtomBrowserContext : public brightray::BrowserContext {
   std::unique_ptr<net::URLRequestJobFactory> CreateURLRequestJobFactory(
       content::ProtocolHandlerMap* protocol_handlers) override;
   net::HttpCache::BackendFactory* CreateHttpCacheBackendFactory(
-      const base::FilePath& base_path) override;
+      const base::FilePath& base_path, bool in_memory) override;
   std::unique_ptr<net::CertVerifier> CreateCertVerifier() override;
   net::SSLConfigService* CreateSSLConfigService() override;
   std::vector<std::string> GetCookieableSchemes() override;
@@ -56,6 +56,11 @@ class AtomBrowserContext : public brightray::BrowserContext {
   std::unique_ptr<AtomPermissionManager> permission_manager_;
   bool use_cache_;
 
+  // HTTP cache configuration, read from |options|.
+  net::BackendType cache_backend_type_;
+  int cache_max_size_;
+  bool cache_memory_only_;
+
   // Managed by brightray::BrowserContext.
   AtomNetworkDelegate* network_delegate_;
 
@@ -0,0 +1,359 @@
+// Copyright (c) 2017 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/crash_report_uploader.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "components/compression/compression_utils.h"
+#include "content/public/browser/browser_thread.h"
+#include "net/base/filename_util.h"
+#include "net/base/load_flags.h"
+#include "net/url_request/url_fetcher.h"
+#include "net/url_request/url_request_context_getter.h"
+#include "net/url_request/url_request_status.h"
+
+using content::BrowserThread;
+
+namespace atom {
+
+namespace {
+
+const base::FilePath::CharType kReportExtension[] = FILE_PATH_LITERAL(".dmp");
+const base::FilePath::CharType kCompressedExtension[] =
+    FILE_PATH_LITERAL(".gz");
+const char kUploadLogName[] = "uploads.log";
+
+// Reports modified more recently than this may still be written by a
+// crashing process.
+const int kMinReportAgeSeconds = 10;
+
+// Delay of the first retry, doubled for each following one.
+const int kRetryDelaySeconds = 60;
+const int kMaxRetryDelaySeconds = 60 * 60;
+
+bool IsCompressedReport(const base::FilePath& path) {
+  return path.MatchesExtension(kCompressedExtension);
+}
+
+bool IsReport(const base::FilePath& path) {
+  if (IsCompressedReport(path))
+    return path.RemoveFinalExtension().MatchesExtension(kReportExtension);
+  return path.MatchesExtension(kReportExtension);
+}
+
+}  // namespace
+
+struct CrashReportUploader::SpoolContents {
+  // Oldest first.
+  std::vector<base::FilePath> reports;
+  int pruned = 0;
+};
+
+struct CrashReportUploader::ReportData {
+  std::string body;
+  std::string boundary;
+  bool compressed = false;
+};
+
+namespace {
+
+struct SpoolEntry {
+  base::FilePath path;
+  base::Time last_modified;
+};
+
+// Deletes the reports that are over the limits, compresses the others if
+// asked to and returns them.
+std::unique_ptr<CrashReportUploader::SpoolContents> ScanSpoolOnFileThread(
+    const CrashReportUploader::Options& options) {
+  std::unique_ptr<CrashReportUploader::SpoolContents> contents(
+      new CrashReportUploader::SpoolContents);
+
+  base::Time now = base::Time::Now();
+  std::vector<SpoolEntry> entries;
+  base::FileEnumerator enumerator(options.directory, false,
+                                  base::FileEnumerator::FILES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    if (!IsReport(path))
+      continue;
+    base::FileEnumerator::FileInfo info = enumerator.GetInfo();
+    if (now - info.GetLastModifiedTime() <
+        base::TimeDelta::FromSeconds(kMinReportAgeSeconds))
+      continue;
+    if (now - info.GetLastModifiedTime() > options.max_age ||
+        info.GetSize() > options.max_report_size) {
+      base::DeleteFile(path, false);
+      contents->pruned++;
+      continue;
+    }
+    entries.push_back({path, info.GetLastModifiedTime()});
+  }
+
+  // Newest first, so the oldest reports are the ones over the limit.
+  std::sort(entries.begin(), entries.end(),
+            [](const SpoolEntry& a, const SpoolEntry& b) {
+              return a.last_modified > b.last_modified;
+            });
+  while (entries.size() > options.max_reports) {
+    base::DeleteFile(entries.back().path, false);
+    entries.pop_back();
+    contents->pruned++;
+  }
+
+  for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+    base::FilePath path = it->path;
+    if (options.compress && !IsCompressedReport(path)) {
+      std::string body;
+      std::string compressed;
+      base::FilePath compressed_path = path.AddExtension(kCompressedExtension);
+      if (base::ReadFileToString(path, &body) &&
+          compression::GzipCompress(body, &compressed) &&
+          base::WriteFile(compressed_path, compressed.data(),
+                          compressed.size()) ==
+              static_cast<int>(compressed.size())) {
+        base::DeleteFile(path, false);
+        path = compressed_path;
+      }
+    }
+    contents->reports.push_back(path);
+  }
+  return contents;
+}
+
+std::unique_ptr<CrashReportUploader::ReportData> ReadReportOnFileThread(
+    const base::FilePath& path) {
+  std::unique_ptr<CrashReportUploader::ReportData> data(
+      new CrashReportUploader::ReportData);
+  if (!base::ReadFileToString(path, &data->body))
+    return nullptr;
+
+  // The MIME boundary is the first line of the body, the header uses it
+  // without the two leading dashes.
+  std::string mime;
+  data->compressed = IsCompressedReport(path);
+  if (data->compressed) {
+    if (!compression::GzipUncompress(data->body, &mime))
+      return nullptr;
+  }
+  const std::string& text = data->compressed ? mime : data->body;
+  size_t end = text.find("\r\n");
+  if (end == std::string::npos || end < 3 ||
+      !base::StartsWith(text, "--", base::CompareCase::SENSITIVE))
+    return nullptr;
+  data->boundary = text.substr(2, end - 2);
+  return data;
+}
+
+// Copies the report to the directory of a file: URL, its name is the id.
+std::string WriteReportToSinkOnFileThread(const base::FilePath& sink,
+                                          const base::FilePath& path,
+                                          const std::string& body) {
+  if (!base::CreateDirectory(sink))
+    return std::string();
+  base::FilePath target = sink.Append(path.BaseName());
+  if (base::WriteFile(target, body.data(), body.size()) !=
+      static_cast<int>(body.size()))
+    return std::string();
+  base::FilePath name = path.BaseName();
+  if (IsCompressedReport(name))
+    name = name.RemoveFinalExtension();
+  return name.RemoveFinalExtension().AsUTF8Unsafe();
+}
+
+// Records the id in the same log the crash handler writes to and removes the
+// report from the spool.
+void FinishReportOnFileThread(const base::FilePath& path,
+                              const std::string& report_id) {
+  if (!report_id.empty()) {
+    int64_t now = base::Time::Now().ToTimeT();
+    std::string line = base::Int64ToString(now) + "," + report_id + "\n";
+    base::FilePath log = path.DirName().AppendASCII(kUploadLogName);
+    if (base::PathExists(log))
+      base::AppendToFile(log, line.data(), line.size());
+    else
+      base::WriteFile(log, line.data(), line.size());
+  }
+  base::DeleteFile(path, false);
+}
+
+}  // namespace
+
+CrashReportUploader::Options::Options()
+    : compress(false),
+      max_reports(20),
+      max_report_size(10 * 1024 * 1024),
+      max_age(base::TimeDelta::FromDays(7)),
+      max_attempts(5) {
+}
+
+CrashReportUploader::Options::Options(const Options& other) = default;
+
+CrashReportUploader::Options::~Options() {
+}
+
+CrashReportUploader::Result::Result() : uploaded(0), failed(0), pruned(0) {
+}
+
+CrashReportUploader::CrashReportUploader(
+    const Options& options,
+    scoped_refptr<net::URLRequestContextGetter> getter)
+    : options_(options),
+      request_context_getter_(getter),
+      retries_(0),
+      weak_factory_(this) {
+}
+
+CrashReportUploader::~CrashReportUploader() {
+}
+
+void CrashReportUploader::Start(const Callback& callback) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  callback_ = callback;
+  ScanSpool();
+}
+
+void CrashReportUploader::ScanSpool() {
+  result_ = Result();
+  BrowserThread::PostTaskAndReplyWithResult(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&ScanSpoolOnFileThread, options_),
+      base::Bind(&CrashReportUploader::OnSpoolScanned,
+                 weak_factory_.GetWeakPtr()));
+}
+
+void CrashReportUploader::OnSpoolScanned(
+    std::unique_ptr<SpoolContents> contents) {
+  result_.pruned = contents->pruned;
+  queue_.assign(contents->reports.begin(), contents->reports.end());
+
+  // Forget the attempts of reports that left the spool.
+  std::map<base::FilePath, int> attempts;
+  for (const auto& path : queue_) {
+    auto it = attempts_.find(path);
+    if (it != attempts_.end())
+      attempts.insert(*it);
+  }
+  attempts_.swap(attempts);
+
+  UploadNext();
+}
+
+void CrashReportUploader::UploadNext() {
+  if (queue_.empty()) {
+    OnPassFinished();
+    return;
+  }
+
+  current_report_ = queue_.front();
+  queue_.pop_front();
+  BrowserThread::PostTaskAndReplyWithResult(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&ReadReportOnFileThread, current_report_),
+      base::Bind(&CrashReportUploader::OnReportRead,
+                 weak_factory_.GetWeakPtr(), current_report_));
+}
+
+void CrashReportUploader::OnReportRead(const base::FilePath& path,
+                                       std::unique_ptr<ReportData> data) {
+  if (!data) {
+    // Not something that can ever be uploaded.
+    attempts_[path] = options_.max_attempts;
+    OnReportDone(path, false, std::string());
+    return;
+  }
+
+  if (options_.upload_url.SchemeIsFile()) {
+    base::FilePath sink;
+    if (!net::FileURLToFilePath(options_.upload_url, &sink)) {
+      OnReportDone(path, false, std::string());
+      return;
+    }
+    BrowserThread::PostTaskAndReplyWithResult(
+        BrowserThread::FILE, FROM_HERE,
+        base::Bind(&WriteReportToSinkOnFileThread, sink, path, data->body),
+        base::Bind(&CrashReportUploader::OnReportDone,
+                   weak_factory_.GetWeakPtr(), path, true));
+    return;
+  }
+
+  fetcher_ = net::URLFetcher::Create(options_.upload_url,
+                                     net::URLFetcher::POST, this);
+  fetcher_->SetRequestContext(request_context_getter_.get());
+  fetcher_->SetLoadFlags(net::LOAD_DO_NOT_SEND_COOKIES |
+                         net::LOAD_DO_NOT_SAVE_COOKIES |
+                         net::LOAD_DISABLE_CACHE);
+  if (data->compressed)
+    fetcher_->AddExtraRequestHeader("Content-Encoding: gzip");
+  fetcher_->SetUploadData("multipart/form-data; boundary=" + data->boundary,
+                          data->body);
+  fetcher_->Start();
+}
+
+void CrashReportUploader::OnURLFetchComplete(const net::URLFetcher* source) {
+  std::unique_ptr<net::URLFetcher> fetcher(std::move(fetcher_));
+  std::string report_id;
+  bool success = source->GetStatus().is_success() &&
+                 source->GetResponseCode() == 200 &&
+                 source->GetResponseAsString(&report_id);
+  base::TrimWhitespaceASCII(report_id, base::TRIM_ALL, &report_id);
+  OnReportDone(current_report_, success, report_id);
+}
+
+void CrashReportUploader::OnReportDone(const base::FilePath& path,
+                                       bool success,
+                                       const std::string& report_id) {
+  // The file sink reports an empty id when the copy failed.
+  if (success && options_.upload_url.SchemeIsFile() && report_id.empty())
+    success = false;
+
+  if (success) {
+    result_.uploaded++;
+    attempts_.erase(path);
+  } else {
+    result_.failed++;
+    if (++attempts_[path] < options_.max_attempts) {
+      UploadNext();
+      return;
+    }
+    // Given up on, the report is dropped without an id.
+    attempts_.erase(path);
+  }
+  BrowserThread::PostTaskAndReply(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&FinishReportOnFileThread, path,
+                 success ? report_id : std::string()),
+      base::Bind(&CrashReportUploader::UploadNext,
+                 weak_factory_.GetWeakPtr()));
+}
+
+void CrashReportUploader::OnPassFinished() {
+  if (!callback_.is_null()) {
+    Callback callback = callback_;
+    callback_.Reset();
+    callback.Run(result_);
+  }
+
+  if (attempts_.empty()) {
+    retries_ = 0;
+    return;
+  }
+
+  int delay = std::min(kRetryDelaySeconds << std::min(retries_, 10),
+                       kMaxRetryDelaySeconds);
+  retries_++;
+  retry_timer_.Start(FROM_HERE, base::TimeDelta::FromSeconds(delay),
+                     base::Bind(&CrashReportUploader::ScanSpool,
+                                base::Unretained(this)));
+}
+
+}  // namespace atom
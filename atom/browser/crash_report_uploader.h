@@ -0,0 +1,109 @@
+// Copyright (c) 2017 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_CRASH_REPORT_UPLOADER_H_
+#define ATOM_BROWSER_CRASH_REPORT_UPLOADER_H_
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "net/url_request/url_fetcher_delegate.h"
+#include "url/gurl.h"
+
+namespace net {
+class URLFetcher;
+class URLRequestContextGetter;
+}
+
+namespace atom {
+
+// Uploads the crash reports that the crash handler wrote to a spool directory
+// instead of uploading them from the crashed process. Reports that fail to
+// upload stay in the spool and are retried later with a backoff.
+class CrashReportUploader : public net::URLFetcherDelegate {
+ public:
+  struct Options {
+    Options();
+    Options(const Options& other);
+    ~Options();
+
+    base::FilePath directory;
+    // A file: URL copies the reports to that directory instead of uploading.
+    GURL upload_url;
+    // Whether spooled reports are gzip-compressed before they are uploaded.
+    bool compress;
+    // Reports beyond these limits are deleted without being uploaded.
+    size_t max_reports;
+    int64_t max_report_size;
+    base::TimeDelta max_age;
+    int max_attempts;
+  };
+
+  struct Result {
+    Result();
+
+    int uploaded;
+    int failed;
+    int pruned;
+  };
+
+  using Callback = base::Callback<void(const Result&)>;
+
+  CrashReportUploader(const Options& options,
+                      scoped_refptr<net::URLRequestContextGetter> getter);
+  ~CrashReportUploader() override;
+
+  // Uploads the spooled reports, |callback| is called once every report has
+  // been tried once.
+  void Start(const Callback& callback);
+
+  // Read on the FILE thread, defined in the .cc file.
+  struct SpoolContents;
+  struct ReportData;
+
+ private:
+  void ScanSpool();
+  void OnSpoolScanned(std::unique_ptr<SpoolContents> contents);
+  void UploadNext();
+  void OnReportRead(const base::FilePath& path,
+                    std::unique_ptr<ReportData> data);
+  void OnReportDone(const base::FilePath& path,
+                    bool success,
+                    const std::string& report_id);
+  void OnPassFinished();
+
+  // net::URLFetcherDelegate:
+  void OnURLFetchComplete(const net::URLFetcher* source) override;
+
+  Options options_;
+  scoped_refptr<net::URLRequestContextGetter> request_context_getter_;
+
+  Callback callback_;
+  Result result_;
+
+  std::deque<base::FilePath> queue_;
+  base::FilePath current_report_;
+  std::unique_ptr<net::URLFetcher> fetcher_;
+
+  // Failed upload attempts of each report that is still in the spool.
+  std::map<base::FilePath, int> attempts_;
+  int retries_;
+  base::OneShotTimer retry_timer_;
+
+  base::WeakPtrFactory<CrashReportUploader> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(CrashReportUploader);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_CRASH_REPORT_UPLOADER_H_
@@ -12,6 +12,7 @@
 #include "atom/browser/extensions/atom_extension_system_factory.h"
 #include "atom/browser/extensions/atom_extensions_browser_client.h"
 #include "atom/browser/extensions/shared_user_script_master.h"
+#include "atom/browser/extensions/tab_helper.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/memory/weak_ptr.h"
@@ -289,6 +290,8 @@ void AtomExtensionSystem::Shared::DisableExtension(
 void AtomExtensionSystem::Shared::NotifyExtensionUnloaded(
     const Extension* extension,
     extensions::UnloadedExtensionReason reason) {
+  // Script handles registered by the extension must not outlive it.
+  TabHelper::UnregisterExtensionScripts(extension->id());
   registry_->TriggerOnUnloaded(extension, reason);
 
   for (content::RenderProcessHost::iterator i(
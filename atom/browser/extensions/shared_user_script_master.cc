@@ -8,9 +8,12 @@
 #include "atom/browser/extensions/shared_user_script_master.h"
 
 #include "atom/browser/extensions/atom_extensions_browser_client.h"
+#include "base/bind.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "chrome/common/extensions/manifest_handlers/content_scripts_handler.h"
 #include "extensions/browser/extension_registry.h"
 #include "extensions/common/host_id.h"
+#include "extensions/common/manifest.h"
 
 namespace extensions {
 
@@ -20,29 +23,97 @@ SharedUserScriptMaster::SharedUserScriptMaster(
               HostID(),
               true /* listen_for_extension_system_loaded */),
       browser_context_(browser_context),
-      extension_registry_observer_(this) {
+      extension_registry_observer_(this),
+      weak_factory_(this) {
   extension_registry_observer_.Add(ExtensionRegistry::Get(browser_context_));
 }
 
 SharedUserScriptMaster::~SharedUserScriptMaster() {
 }
 
+SharedUserScriptMaster::LoadedScripts::LoadedScripts()
+    : incognito_enabled(false) {
+}
+
+SharedUserScriptMaster::LoadedScripts::LoadedScripts(
+    const LoadedScripts& other) = default;
+
+SharedUserScriptMaster::LoadedScripts::~LoadedScripts() {
+}
+
 void SharedUserScriptMaster::OnExtensionLoaded(
     content::BrowserContext* browser_context,
     const Extension* extension) {
-  loader_.AddScripts(GetScriptsMetadata(extension));
+  auto it = loaded_scripts_.find(extension->id());
+  if (it != loaded_scripts_.end()) {
+    // Reloading an unchanged extension keeps the scripts the renderers
+    // already have, otherwise every script is sent to them again.
+    if (pending_removals_.erase(extension->id()) &&
+        CanReuseScripts(extension, it->second))
+      return;
+    loader_.RemoveScripts(it->second.ids);
+    loaded_scripts_.erase(it);
+  }
+
+  std::unique_ptr<UserScriptList> scripts = GetScriptsMetadata(extension);
+  if (scripts->empty())
+    return;
+
+  LoadedScripts& loaded = loaded_scripts_[extension->id()];
+  loaded.version = *extension->version();
+  loaded.incognito_enabled = AtomExtensionsBrowserClient::IsIncognitoEnabled(
+      extension->id(), browser_context_);
+  for (const std::unique_ptr<UserScript>& script : *scripts)
+    loaded.ids.insert(UserScriptIDPair(script->id(), script->host_id()));
+  loader_.AddScripts(std::move(scripts));
 }
 
 void SharedUserScriptMaster::OnExtensionUnloaded(
     content::BrowserContext* browser_context,
     const Extension* extension,
     UnloadedExtensionReason reason) {
-  const UserScriptList& script_list =
-      ContentScriptsInfo::GetContentScripts(extension);
+  if (!loaded_scripts_.count(extension->id()))
+    return;
+
+  // AddExtension unloads and loads an extension in the same task when it is
+  // added again, so wait for the end of the task before removing anything.
+  if (pending_removals_.empty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::Bind(&SharedUserScriptMaster::FlushPendingRemovals,
+                   weak_factory_.GetWeakPtr()));
+  }
+  pending_removals_.insert(extension->id());
+}
+
+bool SharedUserScriptMaster::CanReuseScripts(
+    const Extension* extension,
+    const LoadedScripts& loaded) const {
+  // The files of unpacked extensions can change without a version bump.
+  if (Manifest::IsUnpackedLocation(extension->location()))
+    return false;
+  if (loaded.version != *extension->version())
+    return false;
+  if (loaded.incognito_enabled !=
+      AtomExtensionsBrowserClient::IsIncognitoEnabled(extension->id(),
+                                                      browser_context_))
+    return false;
+  return loaded.ids.size() ==
+      ContentScriptsInfo::GetContentScripts(extension).size();
+}
+
+void SharedUserScriptMaster::FlushPendingRemovals() {
   std::set<UserScriptIDPair> scripts_to_remove;
-  for (const std::unique_ptr<UserScript>& script : script_list)
-    scripts_to_remove.insert(UserScriptIDPair(script->id(), script->host_id()));
-  loader_.RemoveScripts(scripts_to_remove);
+  for (const std::string& id : pending_removals_) {
+    auto it = loaded_scripts_.find(id);
+    if (it == loaded_scripts_.end())
+      continue;
+    scripts_to_remove.insert(it->second.ids.begin(), it->second.ids.end());
+    loaded_scripts_.erase(it);
+  }
+  pending_removals_.clear();
+  if (!scripts_to_remove.empty())
+    loader_.RemoveScripts(scripts_to_remove);
 }
 
 std::unique_ptr<UserScriptList> SharedUserScriptMaster::GetScriptsMetadata(
@@ -5,10 +5,14 @@
 #ifndef ATOM_BROWSER_EXTENSIONS_SHARED_USER_SCRIPT_MASTER_H_
 #define ATOM_BROWSER_EXTENSIONS_SHARED_USER_SCRIPT_MASTER_H_
 
+#include <map>
 #include <memory>
 #include <set>
+#include <string>
 
+#include "base/memory/weak_ptr.h"
 #include "base/scoped_observer.h"
+#include "base/version.h"
 #include "extensions/browser/extension_registry_observer.h"
 #include "extensions/browser/extension_user_script_loader.h"
 #include "extensions/common/extension.h"
@@ -41,11 +45,31 @@ class SharedUserScriptMaster : public ExtensionRegistryObserver {
                            const Extension* extension,
                            UnloadedExtensionReason reason) override;
 
+  // The scripts handed to |loader_| for one extension.
+  struct LoadedScripts {
+    LoadedScripts();
+    LoadedScripts(const LoadedScripts& other);
+    ~LoadedScripts();
+
+    base::Version version;
+    bool incognito_enabled;
+    std::set<UserScriptIDPair> ids;
+  };
+
   // Gets an extension's scripts' metadata; i.e., gets a list of UserScript
   // objects that contains script info, but not the contents of the scripts.
   std::unique_ptr<UserScriptList> GetScriptsMetadata(
       const Extension* extension);
 
+  // Whether the scripts already in |loader_| for |extension| can be kept
+  // instead of being loaded and sent to renderers again.
+  bool CanReuseScripts(const Extension* extension,
+                       const LoadedScripts& loaded) const;
+
+  // Removes the scripts of the extensions that were unloaded and not loaded
+  // again in the same task.
+  void FlushPendingRemovals();
+
   // Script loader that handles loading contents of scripts into shared memory
   // and notifying renderers of scripts in shared memory.
   ExtensionUserScriptLoader loader_;
@@ -56,6 +80,13 @@ class SharedUserScriptMaster : public ExtensionRegistryObserver {
   ScopedObserver<ExtensionRegistry, ExtensionRegistryObserver>
       extension_registry_observer_;
 
+  // Keyed by extension id.
+  std::map<std::string, LoadedScripts> loaded_scripts_;
+  // Extensions that were unloaded but whose scripts are still in |loader_|.
+  std::set<std::string> pending_removals_;
+
+  base::WeakPtrFactory<SharedUserScriptMaster> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(SharedUserScriptMaster);
 };
 
@@ -4,13 +4,15 @@
 
 #include "atom/browser/extensions/tab_helper.h"
 
-#include <map>
+#include <unordered_map>
 #include <utility>
 #include "atom/browser/extensions/atom_extension_web_contents_observer.h"
 #include "atom/browser/native_window.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
+#include "base/lazy_instance.h"
+#include "base/sha1.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/browser/brave_browser_context.h"
 #include "brave/browser/guest_view/tab_view/tab_view_guest.h"
@@ -26,8 +28,6 @@
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/navigation_entry.h"
 #include "content/public/browser/render_frame_host.h"
-#include "content/public/browser/render_process_host.h"
-#include "content/public/browser/render_view_host.h"
 #include "content/public/browser/web_contents.h"
 #include "extensions/browser/component_extension_resource_manager.h"
 #include "extensions/browser/extension_api_frame_id_map.h"
@@ -63,7 +63,26 @@ const char kPinnedKey[] = "pinned";
 const char kSelectedKey[] = "selected";
 }  // namespace keys
 
-static std::map<int32_t, std::pair<int, int>> render_view_map_;
+// All live tabs keyed by tab id. Entries are added when the TabHelper is
+// created and removed when its WebContents is destroyed, so lookups never
+// insert and never have to walk the browser list.
+static std::unordered_map<int32_t, extensions::TabHelper*> tab_id_map_;
+
+// Scripts registered with TabHelper::RegisterScript, keyed by handle.
+struct RegisteredScript {
+  std::string extension_id;
+  std::string key;
+  std::string code;
+  int ref_count;
+};
+struct RegisteredScripts {
+  std::unordered_map<int, RegisteredScript> scripts;
+  // Handles keyed by the extension id and the hash of the code.
+  std::unordered_map<std::string, int> handles;
+  int next_handle = 1;
+};
+static base::LazyInstance<RegisteredScripts>::Leaky registered_scripts_ =
+    LAZY_INSTANCE_INITIALIZER;
 
 namespace extensions {
 
@@ -73,6 +92,10 @@ TabManager* GetTabManager() {
   return g_browser_process->GetTabManager();
 }
 
+memory::GuestTabManager* GetGuestTabManager() {
+  return static_cast<memory::GuestTabManager*>(GetTabManager());
+}
+
 }  // namespace
 
 TabHelper::TabHelper(content::WebContents* contents)
@@ -91,7 +114,8 @@ TabHelper::TabHelper(content::WebContents* contents)
   SessionTabHelper::CreateForWebContents(contents);
   SetWindowId(-1);
 
-  RenderViewCreated(contents->GetRenderViewHost());
+  tab_id_map_[session_id()] = this;
+
   contents->ForEachFrame(
       base::Bind(&TabHelper::SetTabId, base::Unretained(this)));
 
@@ -206,6 +230,7 @@ content::WebContents* TabHelper::DetachGuest() {
 
 void TabHelper::DidAttach() {
   MaybeRequestWindowClose();
+  GetGuestTabManager()->MaybeStartBackgroundLoads();
 
   if (active_) {
     browser_->tab_strip_model()->ActivateTabAt(get_tab_strip_index(), true);
@@ -377,17 +402,34 @@ void TabHelper::SetActive(bool active) {
 }
 
 void TabHelper::WasShown() {
-  if (discarded_) {
-    // load the tab if it is shown without being activate (tab preview)
-    discarded_ = false;
-    SetAutoDiscardable(true);
-    auto helper = content::RestoreHelper::FromWebContents(web_contents());
-    if (helper) {
-      helper->RemoveRestoreHelper();
-    }
+  // load the tab if it is shown without being activate (tab preview)
+  LoadIfDiscarded();
+}
 
-    web_contents()->GetController().Reload(content::ReloadType::NORMAL, true);
+void TabHelper::DidStopLoading() {
+  GetGuestTabManager()->OnBackgroundLoadFinished(web_contents());
+}
+
+bool TabHelper::LoadIfDiscarded() {
+  if (!discarded_)
+    return false;
+
+  discarded_ = false;
+  SetAutoDiscardable(true);
+  auto helper = content::RestoreHelper::FromWebContents(web_contents());
+  if (helper) {
+    helper->RemoveRestoreHelper();
   }
+
+  // Without an entry to reload nothing starts loading, so no DidStopLoading
+  // would ever follow.
+  content::NavigationController& controller = web_contents()->GetController();
+  controller.Reload(content::ReloadType::NORMAL, true);
+  return controller.GetPendingEntry() != nullptr;
+}
+
+void TabHelper::Prewarm() {
+  GetGuestTabManager()->QueueBackgroundLoad(web_contents());
 }
 
 void TabHelper::UpdateBrowser(Browser* browser) {
@@ -502,12 +544,6 @@ void TabHelper::SetOpener(int openerTabId) {
   opener_tab_id_ = openerTabId;
 }
 
-void TabHelper::RenderViewCreated(content::RenderViewHost* render_view_host) {
-  render_view_map_[session_id()] = std::make_pair(
-      render_view_host->GetProcess()->GetID(),
-      render_view_host->GetRoutingID());
-}
-
 void TabHelper::RenderFrameCreated(content::RenderFrameHost* host) {
   SetTabId(host);
 }
@@ -516,7 +552,11 @@ void TabHelper::WebContentsDestroyed() {
   if (browser())
     SetBrowser(nullptr);
 
-  render_view_map_.erase(session_id());
+  GetGuestTabManager()->CancelBackgroundLoad(web_contents());
+
+  auto it = tab_id_map_.find(session_id());
+  if (it != tab_id_map_.end() && it->second == this)
+    tab_id_map_.erase(it);
 }
 
 void TabHelper::SetTabId(content::RenderFrameHost* render_frame_host) {
@@ -623,6 +663,81 @@ bool TabHelper::ExecuteScriptInTab(mate::Arguments* args) {
   return true;
 }
 
+// static
+int TabHelper::RegisterScript(const std::string& extension_id,
+                              const std::string& code) {
+  RegisteredScripts& registered = registered_scripts_.Get();
+  std::string key = extension_id + ":" + base::SHA1HashString(code);
+  auto it = registered.handles.find(key);
+  if (it != registered.handles.end()) {
+    registered.scripts[it->second].ref_count++;
+    return it->second;
+  }
+
+  int handle = registered.next_handle++;
+  registered.scripts[handle] = {extension_id, key, code, 1};
+  registered.handles[key] = handle;
+  return handle;
+}
+
+// static
+void TabHelper::UnregisterScript(int handle) {
+  RegisteredScripts& registered = registered_scripts_.Get();
+  auto it = registered.scripts.find(handle);
+  if (it == registered.scripts.end() || --it->second.ref_count > 0)
+    return;
+
+  registered.handles.erase(it->second.key);
+  registered.scripts.erase(it);
+}
+
+// static
+void TabHelper::UnregisterExtensionScripts(const std::string& extension_id) {
+  RegisteredScripts& registered = registered_scripts_.Get();
+  for (auto it = registered.scripts.begin(); it != registered.scripts.end();) {
+    if (it->second.extension_id == extension_id) {
+      registered.handles.erase(it->second.key);
+      it = registered.scripts.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+bool TabHelper::ExecuteRegisteredScript(mate::Arguments* args) {
+  int handle;
+  if (!args->GetNext(&handle)) {
+    args->ThrowError("handle is a required field");
+    return false;
+  }
+
+  const auto& scripts = registered_scripts_.Get().scripts;
+  auto it = scripts.find(handle);
+  if (it == scripts.end()) {
+    args->ThrowError("Unknown script handle");
+    return false;
+  }
+
+  base::DictionaryValue options;
+  args->GetNext(&options);
+
+  extensions::ScriptExecutor::ResultType result;
+  extensions::ScriptExecutor::ExecuteScriptCallback callback;
+  if (!args->GetNext(&callback)) {
+    callback = extensions::ScriptExecutor::ExecuteScriptCallback();
+    result = extensions::ScriptExecutor::NO_RESULT;
+  } else {
+    result = extensions::ScriptExecutor::JSON_SERIALIZED_RESULT;
+  }
+
+  if (!script_executor())
+    return false;
+
+  ExecuteCode(it->second.extension_id, options, result, callback, GURL(),
+              it->second.code);
+  return true;
+}
+
 void TabHelper::ExecuteScript(
     const std::string extension_id,
     std::unique_ptr<base::DictionaryValue> options,
@@ -631,28 +746,39 @@ void TabHelper::ExecuteScript(
     const GURL& file_url,
     bool success,
     std::unique_ptr<std::string> code_string) {
+  ExecuteCode(extension_id, *options, result, callback, file_url,
+              *code_string);
+}
+
+void TabHelper::ExecuteCode(
+    const std::string& extension_id,
+    const base::DictionaryValue& options,
+    extensions::ScriptExecutor::ResultType result,
+    const extensions::ScriptExecutor::ExecuteScriptCallback& callback,
+    const GURL& file_url,
+    const std::string& code) {
   extensions::ScriptExecutor* executor = script_executor();
 
   bool all_frames = false;
-  options->GetBoolean("allFrames", &all_frames);
+  options.GetBoolean("allFrames", &all_frames);
   extensions::ScriptExecutor::FrameScope frame_scope =
       all_frames
           ? extensions::ScriptExecutor::INCLUDE_SUB_FRAMES
           : extensions::ScriptExecutor::SINGLE_FRAME;
 
   int frame_id = extensions::ExtensionApiFrameIdMap::kTopFrameId;
-  options->GetInteger("frameId", &frame_id);
+  options.GetInteger("frameId", &frame_id);
 
   bool match_about_blank = false;
-  options->GetBoolean("matchAboutBlank", &match_about_blank);
+  options.GetBoolean("matchAboutBlank", &match_about_blank);
 
   bool main_world = false;
-  options->GetBoolean("mainWorld", &main_world);
+  options.GetBoolean("mainWorld", &main_world);
 
   extensions::UserScript::RunLocation run_at =
     extensions::UserScript::UNDEFINED;
   std::string run_at_string = "undefined";
-  options->GetString("runAt", &run_at_string);
+  options.GetString("runAt", &run_at_string);
   if (run_at_string == "document_start") {
     run_at = extensions::UserScript::DOCUMENT_START;
   } else if (run_at_string == "document_end") {
@@ -664,7 +790,7 @@ void TabHelper::ExecuteScript(
   executor->ExecuteScript(
       HostID(HostID::EXTENSIONS, extension_id),
       extensions::ScriptExecutor::JAVASCRIPT,
-      *code_string,
+      code,
       frame_scope,
       frame_id,
       match_about_blank ? extensions::ScriptExecutor::MATCH_ABOUT_BLANK
@@ -687,13 +813,20 @@ int TabHelper::get_tab_strip_index() const {
   return TabStripModel::kNoTab;
 }
 
+// static
+TabHelper* TabHelper::FromTabId(int32_t tab_id) {
+  auto it = tab_id_map_.find(tab_id);
+  if (it == tab_id_map_.end())
+    return nullptr;
+
+  return it->second;
+}
+
 // static
 content::WebContents* TabHelper::GetTabById(int32_t tab_id) {
-  content::RenderViewHost* rvh =
-      content::RenderViewHost::FromID(render_view_map_[tab_id].first,
-                                      render_view_map_[tab_id].second);
-  if (rvh) {
-    return content::WebContents::FromRenderViewHost(rvh);
+  auto tab_helper = FromTabId(tab_id);
+  if (tab_helper) {
+    return tab_helper->web_contents();
   } else {
     return NULL;
   }
@@ -32,7 +32,6 @@ class TabViewGuest;
 namespace content {
 class BrowserContext;
 class RenderFrameHost;
-class RenderViewHost;
 }
 
 namespace mate {
@@ -99,6 +98,14 @@ class TabHelper : public content::WebContentsObserver,
 
   bool IsDiscarded();
 
+  // Starts loading a tab that was restored discarded without activating it.
+  // Returns false if the tab was not discarded by TabHelper::Discard or has no
+  // navigation entry to load.
+  bool LoadIfDiscarded();
+
+  // Loads the tab in the background once a load slot is available.
+  void Prewarm();
+
   void DidAttach();
 
   void SetTabValues(const base::DictionaryValue& values);
@@ -110,6 +117,20 @@ class TabHelper : public content::WebContentsObserver,
 
   bool ExecuteScriptInTab(mate::Arguments* args);
 
+  // Registers |code| so it can be run in any tab by handle instead of passing
+  // the source with every call. Registering the same code again for the same
+  // extension returns the same handle, and each registration must be matched
+  // by an UnregisterScript call.
+  static int RegisterScript(const std::string& extension_id,
+                            const std::string& code);
+  static void UnregisterScript(int handle);
+  // Drops every script registered by |extension_id|, whatever its ref count.
+  static void UnregisterExtensionScripts(const std::string& extension_id);
+
+  // Runs a script added with RegisterScript, takes the same options and
+  // callback as ExecuteScriptInTab.
+  bool ExecuteRegisteredScript(mate::Arguments* args);
+
   ScriptExecutor* script_executor() const {
     return script_executor_.get();
   }
@@ -136,6 +157,10 @@ class TabHelper : public content::WebContentsObserver,
   // for a NULL WebContents or if the WebContents has no TabHelper.
   static int32_t IdForTab(const content::WebContents* tab);
 
+  // Returns the TabHelper for |tab_id| or nullptr if there is no live tab
+  // with that id. This is a constant time lookup.
+  static TabHelper* FromTabId(int32_t tab_id);
+
   static content::WebContents* GetTabById(int tab_id,
                          content::BrowserContext* browser_context);
   static content::WebContents* GetTabById(int32_t tab_id);
@@ -177,15 +202,22 @@ class TabHelper : public content::WebContentsObserver,
       const GURL& file_url,
       bool success,
       std::unique_ptr<std::string> code_string);
+  void ExecuteCode(
+      const std::string& extension_id,
+      const base::DictionaryValue& options,
+      extensions::ScriptExecutor::ResultType result,
+      const extensions::ScriptExecutor::ExecuteScriptCallback& callback,
+      const GURL& file_url,
+      const std::string& code);
 
   // content::WebContentsObserver overrides.
-  void RenderViewCreated(content::RenderViewHost* render_view_host) override;
   void RenderFrameCreated(content::RenderFrameHost* host) override;
   void WebContentsDestroyed() override;
   void DidCloneToNewWebContents(
       content::WebContents* old_web_contents,
       content::WebContents* new_web_contents) override;
   void WasShown() override;
+  void DidStopLoading() override;
 
   // Our content script observers. Declare at top so that it will outlive all
   // other members, since they might add themselves as observers.
@@ -17,6 +17,7 @@
 #include "base/message_loop/message_loop.h"
 #include "base/path_service.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/common/extensions/file_bindings.h"
 #include "brave/common/extensions/path_bindings.h"
 #include "brave/common/extensions/shared_memory_bindings.h"
@@ -128,6 +129,7 @@ JavascriptEnvironment::JavascriptEnvironment()
       handle_scope_(isolate_),
       context_holder_(new gin::ContextHolder(isolate_)),
       source_map_(GetModuleSearchPaths()) {
+  TRACE_EVENT0("electron.startup", "JavascriptEnvironment::CreateContext");
   v8::Local<v8::ObjectTemplate> templ = ObjectTemplateBuilder(isolate_).Build();
   ModuleRegistry::RegisterGlobals(isolate_, templ);
 
@@ -191,6 +193,7 @@ void JavascriptEnvironment::OnMessageLoopDestroying() {
 }
 
 bool JavascriptEnvironment::Initialize() {
+  TRACE_EVENT0("electron.startup", "JavascriptEnvironment::Initialize");
   auto cmd = base::CommandLine::ForCurrentProcess();
 
   // --js-flags.
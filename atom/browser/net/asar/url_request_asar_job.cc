@@ -16,6 +16,7 @@
 #include "base/strings/string_util.h"
 #include "base/synchronization/lock.h"
 #include "base/task_runner.h"
+#include "base/trace_event/trace_event.h"
 #include "net/base/file_stream.h"
 #include "net/base/filename_util.h"
 #include "net/base/io_buffer.h"
@@ -100,6 +101,8 @@ void URLRequestAsarJob::InitializeFileJob() {
 }
 
 void URLRequestAsarJob::Start() {
+  TRACE_EVENT1("electron.asar", "URLRequestAsarJob::Start",
+               "path", full_path_.AsUTF8Unsafe());
   file_task_runner_->PostTaskAndReply(
       FROM_HERE,
       base::Bind(&Initialize,
@@ -143,6 +146,8 @@ void URLRequestAsarJob::Kill() {
 }
 
 int URLRequestAsarJob::ReadRawData(net::IOBuffer* dest, int dest_size) {
+  TRACE_EVENT1("electron.asar", "URLRequestAsarJob::ReadRawData",
+               "size", dest_size);
   if (remaining_bytes_ < dest_size)
     dest_size = static_cast<int>(remaining_bytes_);
 
@@ -10,10 +10,13 @@
 #include "atom/common/native_mate_converters/net_converter.h"
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
+#include "base/trace_event/trace_event.h"
 #include "chrome/browser/devtools/devtools_network_transaction.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/websocket_handshake_request_info.h"
 #include "extensions/features/features.h"
+#include "net/base/load_timing_info.h"
+#include "net/log/net_log_source.h"
 #include "net/url_request/url_request.h"
 
 #if BUILDFLAG(ENABLE_EXTENSIONS)
@@ -60,8 +63,16 @@ struct ResponseHeadersContainer {
 
 
 
+// Indexed by AtomNetworkDelegate::ResponseEvent.
+const char* const kResponseEventNames[] = {
+  "onBeforeRequest",
+  "onBeforeSendHeaders",
+  "onHeadersReceived",
+};
+
 void RunSimpleListener(const AtomNetworkDelegate::SimpleListener& listener,
                        std::unique_ptr<base::DictionaryValue> details) {
+  TRACE_EVENT0("electron.net", "AtomNetworkDelegate::RunSimpleListener");
   return listener.Run(*(details.get()));
 }
 
@@ -69,6 +80,7 @@ void RunResponseListener(
     const AtomNetworkDelegate::ResponseListener& listener,
     std::unique_ptr<base::DictionaryValue> details,
     const AtomNetworkDelegate::ResponseCallback& callback) {
+  TRACE_EVENT0("electron.net", "AtomNetworkDelegate::RunResponseListener");
   return listener.Run(*(details.get()), callback);
 }
 
@@ -369,6 +381,29 @@ void AtomNetworkDelegate::OnCompleted(net::URLRequest* request, bool started) {
   // OnCompleted may happen before other events.
   callbacks_.erase(request->identifier());
 
+  if (started && request->status().is_success() &&
+      request->url().SchemeIsHTTPOrHTTPS()) {
+    if (request->was_cached()) {
+      cache_stats_.hits++;
+      cache_stats_.bytes_from_cache +=
+          request->received_response_content_length();
+    } else {
+      cache_stats_.misses++;
+      cache_stats_.bytes_from_network += request->GetTotalReceivedBytes();
+
+      // A socket that was never used before and did not have to be connected
+      // for this request was most likely opened ahead of time by a
+      // preconnect, see PreconnectStats::sockets_used.
+      net::LoadTimingInfo load_timing;
+      request->GetLoadTimingInfo(&load_timing);
+      if (preconnect_stats_.sockets_requested > 0 &&
+          load_timing.socket_log_id != net::NetLogSource::kInvalidId &&
+          !load_timing.socket_reused &&
+          load_timing.connect_timing.connect_start.is_null())
+        preconnect_stats_.sockets_used++;
+    }
+  }
+
   if (request->status().status() == net::URLRequestStatus::FAILED ||
       request->status().status() == net::URLRequestStatus::CANCELED) {
     // Error event.
@@ -423,6 +458,12 @@ int AtomNetworkDelegate::HandleResponseEvent(
   // The |request| could be destroyed before the |callback| is called.
   callbacks_[request->identifier()] = callback;
 
+  // Covers the round trip to the listener in the UI thread, which holds the
+  // request back.
+  TRACE_EVENT_ASYNC_BEGIN1("electron.net", "AtomNetworkDelegate::Listener",
+                           request->identifier(),
+                           "event", kResponseEventNames[type]);
+
   ResponseCallback response =
       base::Bind(&AtomNetworkDelegate::OnListenerResultInUI<Out>,
                  base::Unretained(this), request->identifier(), out);
@@ -451,6 +492,8 @@ void AtomNetworkDelegate::HandleSimpleEvent(
 template<typename T>
 void AtomNetworkDelegate::OnListenerResultInIO(
     uint64_t id, T out, std::unique_ptr<base::DictionaryValue> response) {
+  TRACE_EVENT_ASYNC_END0("electron.net", "AtomNetworkDelegate::Listener", id);
+
   // The request has been destroyed.
   if (!base::ContainsKey(callbacks_, id))
     return;
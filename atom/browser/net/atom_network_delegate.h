@@ -57,9 +57,39 @@ class AtomNetworkDelegate : public brightray::NetworkDelegate {
     ResponseListener listener;
   };
 
+  // Counts of the HTTP responses served from the cache or the network.
+  struct CacheStats {
+    CacheStats()
+        : hits(0), misses(0), bytes_from_cache(0), bytes_from_network(0) {}
+
+    int64_t hits;
+    int64_t misses;
+    int64_t bytes_from_cache;
+    int64_t bytes_from_network;
+  };
+
+  // Counts of the sockets opened by Session::Preconnect and of the requests
+  // that were sent on one of them.
+  struct PreconnectStats {
+    PreconnectStats() : sockets_requested(0), sockets_used(0) {}
+
+    int64_t sockets_requested;
+    // Approximate: counts requests sent on a fresh socket they did not have
+    // to connect themselves. Most are preconnected sockets, but a socket
+    // connected for another request that was cancelled also matches.
+    int64_t sockets_used;
+  };
+
   AtomNetworkDelegate();
   ~AtomNetworkDelegate() override;
 
+  // Must be called in IO thread.
+  const CacheStats& cache_stats() const { return cache_stats_; }
+  const PreconnectStats& preconnect_stats() const { return preconnect_stats_; }
+  void OnPreconnect(int num_sockets) {
+    preconnect_stats_.sockets_requested += num_sockets;
+  }
+
   void SetSimpleListenerInIO(SimpleEvent type,
                              const URLPatterns& patterns,
                              const SimpleListener& callback);
@@ -122,6 +152,9 @@ class AtomNetworkDelegate : public brightray::NetworkDelegate {
   // Client id for devtools network emulation.
   std::string client_id_;
 
+  CacheStats cache_stats_;
+  PreconnectStats preconnect_stats_;
+
   DISALLOW_COPY_AND_ASSIGN(AtomNetworkDelegate);
 };
 
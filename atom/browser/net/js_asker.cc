@@ -16,7 +16,8 @@ namespace internal {
 namespace {
 
 // The callback which is passed to |handler|.
-void HandlerCallback(const BeforeStartCallback& before_start,
+void HandlerCallback(bool convert_options,
+                     const BeforeStartCallback& before_start,
                      const ResponseCallback& callback,
                      mate::Arguments* args) {
   // If there is no argument passed then we failed.
@@ -32,9 +33,14 @@ void HandlerCallback(const BeforeStartCallback& before_start,
   before_start.Run(args->isolate(), value);
 
   // Pass whatever user passed to the actaul request job.
-  V8ValueConverter converter;
-  v8::Local<v8::Context> context = args->isolate()->GetCurrentContext();
-  std::unique_ptr<base::Value> options(converter.FromV8Value(value, context));
+  std::unique_ptr<base::Value> options;
+  if (convert_options) {
+    V8ValueConverter converter;
+    v8::Local<v8::Context> context = args->isolate()->GetCurrentContext();
+    options.reset(converter.FromV8Value(value, context));
+  } else {
+    options.reset(new base::DictionaryValue);
+  }
   content::BrowserThread::PostTask(
       content::BrowserThread::IO, FROM_HERE,
       base::Bind(callback, true, base::Passed(&options)));
@@ -45,6 +51,7 @@ void HandlerCallback(const BeforeStartCallback& before_start,
 void AskForOptions(v8::Isolate* isolate,
                    const JavaScriptHandler& handler,
                    std::unique_ptr<base::DictionaryValue> request_details,
+                   bool convert_options,
                    const BeforeStartCallback& before_start,
                    const ResponseCallback& callback) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -55,7 +62,8 @@ void AskForOptions(v8::Isolate* isolate,
   handler.Run(
       *(request_details.get()),
       mate::ConvertToV8(isolate,
-                        base::Bind(&HandlerCallback, before_start, callback)));
+                        base::Bind(&HandlerCallback, convert_options,
+                                   before_start, callback)));
 }
 
 bool IsErrorOptions(base::Value* value, int* error) {
@@ -4,17 +4,16 @@
 
 #include "atom/browser/net/url_request_fetch_job.h"
 
-#include <algorithm>
 #include <string>
 
-#include "base/memory/ptr_util.h"
 #include "base/strings/string_util.h"
 #include "native_mate/dictionary.h"
+#include "net/base/elements_upload_data_stream.h"
 #include "net/base/io_buffer.h"
 #include "net/base/net_errors.h"
+#include "net/base/upload_bytes_element_reader.h"
 #include "net/http/http_response_headers.h"
-#include "net/url_request/url_fetcher.h"
-#include "net/url_request/url_fetcher_response_writer.h"
+#include "net/url_request/url_request_context.h"
 
 using content::BrowserThread;
 
@@ -22,64 +21,27 @@ namespace atom {
 
 namespace {
 
-// Convert string to RequestType.
-net::URLFetcher::RequestType GetRequestType(const std::string& raw) {
+// Convert string to a supported request method.
+std::string GetRequestMethod(const std::string& raw) {
   std::string method = base::ToUpperASCII(raw);
-  if (method.empty() || method == "GET")
-    return net::URLFetcher::GET;
-  else if (method == "POST")
-    return net::URLFetcher::POST;
-  else if (method == "HEAD")
-    return net::URLFetcher::HEAD;
-  else if (method == "DELETE")
-    return net::URLFetcher::DELETE_REQUEST;
-  else if (method == "PUT")
-    return net::URLFetcher::PUT;
-  else if (method == "PATCH")
-    return net::URLFetcher::PATCH;
+  if (method == "POST" || method == "HEAD" || method == "DELETE" ||
+      method == "PUT" || method == "PATCH")
+    return method;
   else  // Use "GET" as fallback.
-    return net::URLFetcher::GET;
+    return "GET";
 }
 
-// Pipe the response writer back to URLRequestFetchJob.
-class ResponsePiper : public net::URLFetcherResponseWriter {
- public:
-  explicit ResponsePiper(URLRequestFetchJob* job)
-      : first_write_(true), job_(job) {}
-
-  // net::URLFetcherResponseWriter:
-  int Initialize(const net::CompletionCallback& callback) override {
-    return net::OK;
-  }
-  int Write(net::IOBuffer* buffer,
-            int num_bytes,
-            const net::CompletionCallback& callback) override {
-    if (first_write_) {
-      // The URLFetcherResponseWriter doesn't have an event when headers have
-      // been read, so we have to emulate by hooking to first write event.
-      job_->HeadersCompleted();
-      first_write_ = false;
-    }
-    return job_->DataAvailable(buffer, num_bytes, callback);
-  }
-  int Finish(int net_error, const net::CompletionCallback& callback) override {
-    return net::OK;
-  }
-
- private:
-  bool first_write_;
-  URLRequestFetchJob* job_;
-
-  DISALLOW_COPY_AND_ASSIGN(ResponsePiper);
-};
-
 }  // namespace
 
 URLRequestFetchJob::URLRequestFetchJob(
     net::URLRequest* request, net::NetworkDelegate* network_delegate)
     : JsAsker<net::URLRequestJob>(request, network_delegate),
-      pending_buffer_size_(0),
-      write_num_bytes_(0) {
+      headers_completed_(false),
+      read_pending_(false) {
+}
+
+URLRequestFetchJob::~URLRequestFetchJob() {
+  StopObservingContext();
 }
 
 void URLRequestFetchJob::BeforeStartInUI(
@@ -126,150 +88,142 @@ void URLRequestFetchJob::StartAsync(std::unique_ptr<base::Value> options) {
   }
 
   // Use |request|'s method if |method| is not specified.
-  net::URLFetcher::RequestType request_type;
   if (method.empty())
-    request_type = GetRequestType(request()->method());
-  else
-    request_type = GetRequestType(method);
-
-  fetcher_ = net::URLFetcher::Create(formated_url, request_type, this);
-  fetcher_->SaveResponseWithWriter(base::WrapUnique(new ResponsePiper(this)));
+    method = request()->method();
+  method = GetRequestMethod(method);
 
   // A request context getter is passed by the user.
-  if (url_request_context_getter_)
-    fetcher_->SetRequestContext(url_request_context_getter_.get());
-  else
-    fetcher_->SetRequestContext(request_context_getter());
+  net::URLRequestContextGetter* context_getter =
+      url_request_context_getter_ ? url_request_context_getter_.get()
+                                  : request_context_getter();
+  net::URLRequestContext* context = context_getter->GetURLRequestContext();
+  if (!context) {
+    NotifyStartError(net::URLRequestStatus(
+          net::URLRequestStatus::FAILED, net::ERR_CONTEXT_SHUT_DOWN));
+    return;
+  }
+  observed_context_getter_ = context_getter;
+  observed_context_getter_->AddObserver(this);
+
+  fetch_request_ = context->CreateRequest(
+      formated_url, request()->priority(), this);
+  fetch_request_->set_method(method);
+  fetch_request_->set_first_party_for_cookies(formated_url);
 
   // Use |request|'s referrer if |referrer| is not specified.
   if (referrer.empty())
-    fetcher_->SetReferrer(request()->referrer());
+    fetch_request_->SetReferrer(request()->referrer());
   else
-    fetcher_->SetReferrer(referrer);
+    fetch_request_->SetReferrer(referrer);
+
+  // Use |request|'s headers.
+  fetch_request_->SetExtraRequestHeaders(request()->extra_request_headers());
 
   // Set the data needed for POSTs.
-  if (upload_data && request_type == net::URLFetcher::POST) {
+  if (upload_data && method == "POST") {
     std::string content_type, data;
     upload_data->GetString("contentType", &content_type);
     upload_data->GetString("data", &data);
-    fetcher_->SetUploadData(content_type, data);
-  }
-
-  // Use |request|'s headers.
-  fetcher_->SetExtraRequestHeaders(
-      request()->extra_request_headers().ToString());
-
-  fetcher_->Start();
-}
-
-void URLRequestFetchJob::HeadersCompleted() {
-  response_info_.reset(new net::HttpResponseInfo);
-  response_info_->headers = fetcher_->GetResponseHeaders();
-  NotifyHeadersComplete();
-}
-
-int URLRequestFetchJob::DataAvailable(net::IOBuffer* buffer,
-                                      int num_bytes,
-                                      const net::CompletionCallback& callback) {
-  // When pending_buffer_ is empty, there's no ReadRawData() operation waiting
-  // for IO completion, we have to save the parameters until the request is
-  // ready to read data.
-  if (!pending_buffer_.get()) {
-    write_buffer_ = buffer;
-    write_num_bytes_ = num_bytes;
-    write_callback_ = callback;
-    return net::ERR_IO_PENDING;
+    fetch_request_->SetExtraRequestHeaderByName(
+        net::HttpRequestHeaders::kContentType, content_type, true);
+    fetch_request_->set_upload(net::ElementsUploadDataStream::CreateWithReader(
+        net::UploadOwnedBytesElementReader::CreateWithString(data), 0));
   }
 
-  // Write data to the pending buffer and clear them after the writing.
-  int bytes_read = BufferCopy(buffer, num_bytes,
-                              pending_buffer_.get(), pending_buffer_size_);
-  ClearPendingBuffer();
-  ReadRawDataComplete(bytes_read);
-  return bytes_read;
+  fetch_request_->Start();
 }
 
 void URLRequestFetchJob::Kill() {
   JsAsker<URLRequestJob>::Kill();
-  fetcher_.reset();
+  headers_completed_ = false;
+  read_pending_ = false;
+  fetch_request_.reset();
+  StopObservingContext();
 }
 
 int URLRequestFetchJob::ReadRawData(net::IOBuffer* dest, int dest_size) {
-  if (GetResponseCode() == 204) {
-    request()->set_received_response_content_length(prefilter_bytes_read());
-    return net::OK;
-  }
-
-  // When write_buffer_ is empty, there is no data valable yet, we have to save
-  // the dest buffer util DataAvailable.
-  if (!write_buffer_.get()) {
-    pending_buffer_ = dest;
-    pending_buffer_size_ = dest_size;
-    return net::ERR_IO_PENDING;
-  }
-
-  // Read from the write buffer and clear them after reading.
-  int bytes_read = BufferCopy(write_buffer_.get(), write_num_bytes_,
-                              dest, dest_size);
-  net::CompletionCallback write_callback = write_callback_;
-  ClearWriteBuffer();
-  write_callback.Run(bytes_read);
-  return bytes_read;
+  if (!fetch_request_)
+    return net::ERR_ABORTED;
+
+  // The inner request writes into |dest| directly, OnReadCompleted is called
+  // when the read doesn't complete synchronously.
+  int result = fetch_request_->Read(dest, dest_size);
+  read_pending_ = result == net::ERR_IO_PENDING;
+  return result;
 }
 
 bool URLRequestFetchJob::GetMimeType(std::string* mime_type) const {
-  if (!response_info_ || !response_info_->headers)
+  if (!headers_completed_ || !fetch_request_ ||
+      !fetch_request_->response_headers())
     return false;
 
-  return response_info_->headers->GetMimeType(mime_type);
+  return fetch_request_->response_headers()->GetMimeType(mime_type);
 }
 
 void URLRequestFetchJob::GetResponseInfo(net::HttpResponseInfo* info) {
-  if (response_info_)
-    *info = *response_info_;
+  if (headers_completed_ && fetch_request_)
+    *info = fetch_request_->response_info();
 }
 
 int URLRequestFetchJob::GetResponseCode() const {
-  if (!response_info_ || !response_info_->headers)
+  if (!headers_completed_ || !fetch_request_ ||
+      !fetch_request_->response_headers())
     return -1;
 
-  return response_info_->headers->response_code();
+  return fetch_request_->GetResponseCode();
 }
 
-void URLRequestFetchJob::OnURLFetchComplete(const net::URLFetcher* source) {
-  if (!response_info_) {
-    // Since we notify header completion only after first write there will be
-    // no response object constructed for http respones with no content 204.
-    // We notify header completion here.
-    HeadersCompleted();
+void URLRequestFetchJob::GetLoadTimingInfo(
+    net::LoadTimingInfo* load_timing_info) const {
+  // Report the timing of the inner request so the time spent on network shows
+  // up for this job.
+  if (headers_completed_ && fetch_request_)
+    fetch_request_->GetLoadTimingInfo(load_timing_info);
+}
+
+int64_t URLRequestFetchJob::GetTotalReceivedBytes() const {
+  return fetch_request_ ? fetch_request_->GetTotalReceivedBytes() : 0;
+}
+
+int64_t URLRequestFetchJob::GetTotalSentBytes() const {
+  return fetch_request_ ? fetch_request_->GetTotalSentBytes() : 0;
+}
+
+void URLRequestFetchJob::OnResponseStarted(net::URLRequest* request,
+                                           int net_error) {
+  if (net_error != net::OK) {
+    NotifyStartError(net::URLRequestStatus::FromError(net_error));
     return;
   }
 
-  ClearPendingBuffer();
-  ClearWriteBuffer();
-
-  if (fetcher_->GetStatus().is_success())
-    ReadRawDataComplete(0);
-  else
-    NotifyStartError(fetcher_->GetStatus());
+  headers_completed_ = true;
+  NotifyHeadersComplete();
 }
 
-int URLRequestFetchJob::BufferCopy(net::IOBuffer* source, int num_bytes,
-                                   net::IOBuffer* target, int target_size) {
-  int bytes_written = std::min(num_bytes, target_size);
-  memcpy(target->data(), source->data(), bytes_written);
-  return bytes_written;
+void URLRequestFetchJob::OnReadCompleted(net::URLRequest* request,
+                                         int bytes_read) {
+  read_pending_ = false;
+  ReadRawDataComplete(bytes_read);
 }
 
-void URLRequestFetchJob::ClearPendingBuffer() {
-  pending_buffer_ = nullptr;
-  pending_buffer_size_ = 0;
+void URLRequestFetchJob::OnContextShuttingDown() {
+  StopObservingContext();
+  fetch_request_.reset();
+
+  if (!headers_completed_) {
+    NotifyStartError(net::URLRequestStatus(
+          net::URLRequestStatus::FAILED, net::ERR_CONTEXT_SHUT_DOWN));
+  } else if (read_pending_) {
+    read_pending_ = false;
+    ReadRawDataComplete(net::ERR_CONTEXT_SHUT_DOWN);
+  }
 }
 
-void URLRequestFetchJob::ClearWriteBuffer() {
-  write_buffer_ = nullptr;
-  write_num_bytes_ = 0;
-  write_callback_.Reset();
+void URLRequestFetchJob::StopObservingContext() {
+  if (observed_context_getter_) {
+    observed_context_getter_->RemoveObserver(this);
+    observed_context_getter_ = nullptr;
+  }
 }
 
 }  // namespace atom
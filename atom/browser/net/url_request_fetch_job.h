@@ -10,21 +10,21 @@
 
 #include "atom/browser/net/js_asker.h"
 #include "browser/url_request_context_getter.h"
-#include "net/url_request/url_fetcher_delegate.h"
+#include "net/url_request/url_request.h"
+#include "net/url_request/url_request_context_getter_observer.h"
 
 namespace atom {
 
+// Serves the response of another request. The body is read by the inner
+// request directly into the consumer's buffer, so there is no copy and at
+// most one read in flight.
 class URLRequestFetchJob : public JsAsker<net::URLRequestJob>,
-                           public net::URLFetcherDelegate,
+                           public net::URLRequest::Delegate,
+                           public net::URLRequestContextGetterObserver,
                            public brightray::URLRequestContextGetter::Delegate {
  public:
   URLRequestFetchJob(net::URLRequest*, net::NetworkDelegate*);
-
-  // Called by response writer.
-  void HeadersCompleted();
-  int DataAvailable(net::IOBuffer* buffer,
-                    int num_bytes,
-                    const net::CompletionCallback& callback);
+  ~URLRequestFetchJob() override;
 
  protected:
   // JsAsker:
@@ -37,28 +37,28 @@ class URLRequestFetchJob : public JsAsker<net::URLRequestJob>,
   bool GetMimeType(std::string* mime_type) const override;
   void GetResponseInfo(net::HttpResponseInfo* info) override;
   int GetResponseCode() const override;
+  void GetLoadTimingInfo(
+      net::LoadTimingInfo* load_timing_info) const override;
+  int64_t GetTotalReceivedBytes() const override;
+  int64_t GetTotalSentBytes() const override;
+
+  // net::URLRequest::Delegate:
+  void OnResponseStarted(net::URLRequest* request, int net_error) override;
+  void OnReadCompleted(net::URLRequest* request, int bytes_read) override;
 
-  // net::URLFetcherDelegate:
-  void OnURLFetchComplete(const net::URLFetcher* source) override;
+  // net::URLRequestContextGetterObserver:
+  void OnContextShuttingDown() override;
 
  private:
-  int BufferCopy(net::IOBuffer* source, int num_bytes,
-                 net::IOBuffer* target, int target_size);
-  void ClearPendingBuffer();
-  void ClearWriteBuffer();
+  void StopObservingContext();
 
   scoped_refptr<net::URLRequestContextGetter> url_request_context_getter_;
-  std::unique_ptr<net::URLFetcher> fetcher_;
-  std::unique_ptr<net::HttpResponseInfo> response_info_;
-
-  // Saved arguments passed to ReadRawData.
-  scoped_refptr<net::IOBuffer> pending_buffer_;
-  int pending_buffer_size_;
-
-  // Saved arguments passed to DataAvailable.
-  scoped_refptr<net::IOBuffer> write_buffer_;
-  int write_num_bytes_;
-  net::CompletionCallback write_callback_;
+  // The getter of the context |fetch_request_| runs in, the request has to go
+  // away before the context does.
+  scoped_refptr<net::URLRequestContextGetter> observed_context_getter_;
+  std::unique_ptr<net::URLRequest> fetch_request_;
+  bool headers_completed_;
+  bool read_pending_;
 
   DISALLOW_COPY_AND_ASSIGN(URLRequestFetchJob);
 };
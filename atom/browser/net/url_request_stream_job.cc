@@ -0,0 +1,342 @@
+// Copyright (c) 2017 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/url_request_stream_job.h"
+
+#include <algorithm>
+#include <string>
+
+#include "atom/common/atom_constants.h"
+#include "atom/common/native_mate_converters/callback.h"
+#include "base/strings/string_number_conversions.h"
+#include "native_mate/dictionary.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
+
+#include "atom/common/node_includes.h"
+
+using content::BrowserThread;
+
+namespace atom {
+
+namespace internal {
+
+// Pulls data from a node Readable stream in UI thread.
+class StreamReader
+    : public base::RefCountedThreadSafe<StreamReader,
+                                        BrowserThread::DeleteOnUIThread> {
+ public:
+  using ReadCallback = base::Callback<void(int)>;
+
+  explicit StreamReader(v8::Isolate* isolate)
+      : isolate_(isolate),
+        ended_(false),
+        failed_(false),
+        reading_(false),
+        chunk_offset_(0),
+        read_size_(0),
+        weak_factory_(this) {}
+
+  // Returns false if |stream| is not a Readable stream.
+  bool Start(v8::Local<v8::Object> stream) {
+    DCHECK_CURRENTLY_ON(BrowserThread::UI);
+    mate::Dictionary dict(isolate_, stream);
+    v8::Local<v8::Value> read, on;
+    if (!dict.Get("read", &read) || !read->IsFunction() ||
+        !dict.Get("on", &on) || !on->IsFunction())
+      return false;
+
+    stream_.Reset(isolate_, stream);
+    Subscribe("readable", &StreamReader::OnReadable);
+    Subscribe("end", &StreamReader::OnEnd);
+    Subscribe("error", &StreamReader::OnError);
+    return true;
+  }
+
+  // Copies up to |buf_size| bytes of the stream's data into |buf| and runs
+  // |callback| in IO thread with the number of bytes or an error.
+  void Read(scoped_refptr<net::IOBuffer> buf,
+            int buf_size,
+            const ReadCallback& callback) {
+    DCHECK_CURRENTLY_ON(BrowserThread::UI);
+    read_buffer_ = buf;
+    read_size_ = buf_size;
+    read_callback_ = callback;
+    TryRead();
+  }
+
+  // Stops reading, the stream is destroyed if it supports it.
+  void Close() {
+    DCHECK_CURRENTLY_ON(BrowserThread::UI);
+    weak_factory_.InvalidateWeakPtrs();
+    read_buffer_ = nullptr;
+    read_callback_.Reset();
+    chunk_.Reset();
+    if (stream_.IsEmpty() || ended_)
+      return;
+
+    v8::Locker locker(isolate_);
+    v8::HandleScope handle_scope(isolate_);
+    v8::Local<v8::Object> stream = stream_.Get(isolate_);
+    v8::Context::Scope context_scope(stream->CreationContext());
+    mate::Dictionary dict(isolate_, stream);
+    v8::Local<v8::Value> destroy;
+    if (dict.Get("destroy", &destroy) && destroy->IsFunction())
+      node::MakeCallback(isolate_, stream, "destroy", 0, nullptr);
+  }
+
+ private:
+  friend struct BrowserThread::DeleteOnThread<BrowserThread::UI>;
+  friend class base::DeleteHelper<StreamReader>;
+
+  ~StreamReader() {}
+
+  void Subscribe(const char* event, void (StreamReader::*method)()) {
+    v8::Local<v8::Value> args[] = {
+      mate::StringToV8(isolate_, event),
+      mate::ConvertToV8(isolate_,
+                        base::Bind(method, weak_factory_.GetWeakPtr())),
+    };
+    node::MakeCallback(isolate_, stream_.Get(isolate_), "on",
+                       arraysize(args), args);
+  }
+
+  void OnReadable() { TryRead(); }
+
+  void OnEnd() {
+    ended_ = true;
+    TryRead();
+  }
+
+  void OnError() {
+    failed_ = true;
+    TryRead();
+  }
+
+  void TryRead() {
+    if (read_callback_.is_null() || reading_)
+      return;
+
+    v8::Locker locker(isolate_);
+    v8::HandleScope handle_scope(isolate_);
+    v8::Local<v8::Object> stream = stream_.Get(isolate_);
+    v8::Context::Scope context_scope(stream->CreationContext());
+
+    if (chunk_.IsEmpty()) {
+      if (failed_) {
+        Complete(net::ERR_FAILED);
+        return;
+      }
+
+      // Returns null when the stream's buffer is empty, then we wait for the
+      // "readable" or "end" event.
+      // Events emitted synchronously by read() must not start another read.
+      reading_ = true;
+      v8::Local<v8::Value> chunk =
+          node::MakeCallback(isolate_, stream, "read", 0, nullptr);
+      reading_ = false;
+      if (chunk.IsEmpty() || chunk->IsNull() || chunk->IsUndefined()) {
+        if (ended_)
+          Complete(0);
+        return;
+      }
+      // Streams with an encoding set return strings, they are sent as UTF-8.
+      if (chunk->IsString()) {
+        std::string data;
+        mate::ConvertFromV8(isolate_, chunk, &data);
+        chunk = node::Buffer::Copy(isolate_, data.data(), data.size())
+            .ToLocalChecked();
+      }
+      if (!node::Buffer::HasInstance(chunk)) {
+        failed_ = true;
+        Complete(net::ERR_FAILED);
+        return;
+      }
+      chunk_.Reset(isolate_, chunk.As<v8::Object>());
+      chunk_offset_ = 0;
+    }
+
+    v8::Local<v8::Object> chunk = chunk_.Get(isolate_);
+    size_t remaining = node::Buffer::Length(chunk) - chunk_offset_;
+    size_t bytes = std::min(remaining, static_cast<size_t>(read_size_));
+    memcpy(read_buffer_->data(), node::Buffer::Data(chunk) + chunk_offset_,
+           bytes);
+    chunk_offset_ += bytes;
+    if (chunk_offset_ == node::Buffer::Length(chunk))
+      chunk_.Reset();
+
+    Complete(static_cast<int>(bytes));
+  }
+
+  void Complete(int result) {
+    BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+                            base::Bind(read_callback_, result));
+    read_buffer_ = nullptr;
+    read_callback_.Reset();
+  }
+
+  v8::Isolate* isolate_;
+  v8::Global<v8::Object> stream_;
+  bool ended_;
+  bool failed_;
+  bool reading_;
+
+  // The part of the last chunk that didn't fit in the read buffer.
+  v8::Global<v8::Object> chunk_;
+  size_t chunk_offset_;
+
+  // The pending read.
+  scoped_refptr<net::IOBuffer> read_buffer_;
+  int read_size_;
+  ReadCallback read_callback_;
+
+  base::WeakPtrFactory<StreamReader> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamReader);
+};
+
+}  // namespace internal
+
+namespace {
+
+bool IsErrorValue(v8::Isolate* isolate,
+                  v8::Local<v8::Value> value,
+                  int* error) {
+  if (value->IsInt32()) {
+    *error = value->Int32Value();
+    return true;
+  }
+  mate::Dictionary dict;
+  return mate::ConvertFromV8(isolate, value, &dict) &&
+         dict.Get("error", error);
+}
+
+}  // namespace
+
+URLRequestStreamJob::URLRequestStreamJob(
+    net::URLRequest* request, net::NetworkDelegate* network_delegate)
+    : JsAsker<net::URLRequestJob>(request, network_delegate),
+      error_(net::ERR_NOT_IMPLEMENTED),
+      weak_factory_(this) {
+}
+
+URLRequestStreamJob::~URLRequestStreamJob() {
+}
+
+void URLRequestStreamJob::BeforeStartInUI(
+    v8::Isolate* isolate, v8::Local<v8::Value> value) {
+  if (IsErrorValue(isolate, value, &error_) || !value->IsObject())
+    return;
+
+  // Either a stream or {statusCode, headers, mimeType, data}.
+  mate::Dictionary options(isolate, value.As<v8::Object>());
+  v8::Local<v8::Object> stream = value.As<v8::Object>();
+  v8::Local<v8::Value> data;
+  if (options.Get("data", &data)) {
+    if (!data->IsObject())
+      return;
+    stream = data.As<v8::Object>();
+  }
+
+  int status_code = net::HTTP_OK;
+  options.Get("statusCode", &status_code);
+  std::string status("HTTP/1.1 ");
+  status.append(base::IntToString(status_code));
+  status.append(" ");
+  status.append(net::GetHttpReasonPhrase(
+      static_cast<net::HttpStatusCode>(status_code)));
+  status.append("\0\0", 2);
+  response_headers_ = new net::HttpResponseHeaders(status);
+  response_headers_->AddHeader(kCORSHeader);
+
+  std::string mime_type;
+  if (options.Get("mimeType", &mime_type)) {
+    response_headers_->AddHeader(
+        std::string(net::HttpRequestHeaders::kContentType) + ": " + mime_type);
+  }
+
+  mate::Dictionary headers;
+  if (options.Get("headers", &headers)) {
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    v8::Local<v8::Array> names;
+    if (headers.GetHandle()->GetOwnPropertyNames(context).ToLocal(&names)) {
+      for (uint32_t i = 0; i < names->Length(); ++i) {
+        std::string name = mate::V8ToString(names->Get(i));
+        std::string header_value;
+        if (headers.Get(name, &header_value))
+          response_headers_->AddHeader(name + ": " + header_value);
+      }
+    }
+  }
+
+  reader_ = new internal::StreamReader(isolate);
+  if (reader_->Start(stream))
+    error_ = net::OK;
+  else
+    reader_ = nullptr;
+}
+
+void URLRequestStreamJob::StartAsync(std::unique_ptr<base::Value> options) {
+  if (error_ != net::OK) {
+    NotifyStartError(net::URLRequestStatus(
+          net::URLRequestStatus::FAILED, error_));
+    return;
+  }
+
+  NotifyHeadersComplete();
+}
+
+bool URLRequestStreamJob::ShouldConvertOptions() const {
+  // The stream is read in UI thread, converting it would copy its internals.
+  return false;
+}
+
+void URLRequestStreamJob::Kill() {
+  weak_factory_.InvalidateWeakPtrs();
+  if (reader_) {
+    BrowserThread::PostTask(
+        BrowserThread::UI, FROM_HERE,
+        base::Bind(&internal::StreamReader::Close, reader_));
+  }
+  JsAsker<net::URLRequestJob>::Kill();
+}
+
+int URLRequestStreamJob::ReadRawData(net::IOBuffer* buf, int buf_size) {
+  if (!reader_)
+    return net::OK;
+
+  BrowserThread::PostTask(
+      BrowserThread::UI, FROM_HERE,
+      base::Bind(&internal::StreamReader::Read, reader_,
+                 make_scoped_refptr(buf), buf_size,
+                 base::Bind(&URLRequestStreamJob::OnReadCompleted,
+                            weak_factory_.GetWeakPtr())));
+  return net::ERR_IO_PENDING;
+}
+
+bool URLRequestStreamJob::GetMimeType(std::string* mime_type) const {
+  if (!response_headers_)
+    return false;
+
+  return response_headers_->GetMimeType(mime_type);
+}
+
+void URLRequestStreamJob::GetResponseInfo(net::HttpResponseInfo* info) {
+  info->headers = response_headers_;
+}
+
+int URLRequestStreamJob::GetResponseCode() const {
+  if (!response_headers_)
+    return -1;
+
+  return response_headers_->response_code();
+}
+
+void URLRequestStreamJob::OnReadCompleted(int result) {
+  ReadRawDataComplete(result);
+}
+
+}  // namespace atom
@@ -0,0 +1,58 @@
+// Copyright (c) 2017 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_URL_REQUEST_STREAM_JOB_H_
+#define ATOM_BROWSER_NET_URL_REQUEST_STREAM_JOB_H_
+
+#include <memory>
+#include <string>
+
+#include "atom/browser/net/js_asker.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "net/url_request/url_request_job.h"
+
+namespace atom {
+
+namespace internal {
+class StreamReader;
+}
+
+// Serves the data of a readable stream returned by the protocol handler.
+// Data is only pulled from the stream when the consumer reads, so the
+// stream's own buffering bounds the memory used by the response.
+class URLRequestStreamJob : public JsAsker<net::URLRequestJob> {
+ public:
+  URLRequestStreamJob(net::URLRequest*, net::NetworkDelegate*);
+  ~URLRequestStreamJob() override;
+
+ protected:
+  // JsAsker:
+  void BeforeStartInUI(v8::Isolate*, v8::Local<v8::Value>) override;
+  void StartAsync(std::unique_ptr<base::Value> options) override;
+  bool ShouldConvertOptions() const override;
+
+  // net::URLRequestJob:
+  void Kill() override;
+  int ReadRawData(net::IOBuffer* buf, int buf_size) override;
+  bool GetMimeType(std::string* mime_type) const override;
+  void GetResponseInfo(net::HttpResponseInfo* info) override;
+  int GetResponseCode() const override;
+
+ private:
+  void OnReadCompleted(int result);
+
+  // Set in UI thread before the job is started.
+  int error_;
+  scoped_refptr<net::HttpResponseHeaders> response_headers_;
+  scoped_refptr<internal::StreamReader> reader_;
+
+  base::WeakPtrFactory<URLRequestStreamJob> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(URLRequestStreamJob);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_URL_REQUEST_STREAM_JOB_H_
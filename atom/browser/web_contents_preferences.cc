@@ -4,9 +4,8 @@
 
 #include "atom/browser/web_contents_preferences.h"
 
-#include <algorithm>
 #include <string>
-#include <vector>
+#include <utility>
 
 #include "atom/browser/native_window.h"
 #include "atom/common/native_mate_converters/value_converter.h"
@@ -28,12 +27,14 @@ DEFINE_WEB_CONTENTS_USER_DATA_KEY(atom::WebContentsPreferences);
 namespace atom {
 
 // static
-std::vector<WebContentsPreferences*> WebContentsPreferences::instances_;
+std::multimap<int, WebContentsPreferences*> WebContentsPreferences::instances_;
 
 WebContentsPreferences::WebContentsPreferences(
     content::WebContents* web_contents,
     const mate::Dictionary& web_preferences)
-    : web_contents_(web_contents) {
+    : content::WebContentsObserver(web_contents),
+      web_contents_(web_contents),
+      process_id_(-1) {
   v8::Isolate* isolate = web_preferences.isolate();
   mate::Dictionary copied(isolate, web_preferences.GetHandle()->Clone());
   // Following fields should not be stored.
@@ -44,13 +45,47 @@ WebContentsPreferences::WebContentsPreferences(
   mate::ConvertFromV8(isolate, copied.GetHandle(), &web_preferences_);
   web_contents->SetUserData(UserDataKey(), base::WrapUnique(this));
 
-  instances_.push_back(this);
+  UpdateProcessID();
 }
 
 WebContentsPreferences::~WebContentsPreferences() {
-  instances_.erase(
-      std::remove(instances_.begin(), instances_.end(), this),
-      instances_.end());
+  RemoveFromIndex();
+}
+
+void WebContentsPreferences::RenderViewCreated(
+    content::RenderViewHost* render_view_host) {
+  UpdateProcessID();
+}
+
+void WebContentsPreferences::RenderViewHostChanged(
+    content::RenderViewHost* old_host,
+    content::RenderViewHost* new_host) {
+  // Cross-site navigations swap the main RenderViewHost, and with it the
+  // render process.
+  UpdateProcessID();
+}
+
+void WebContentsPreferences::UpdateProcessID() {
+  content::RenderProcessHost* host = web_contents_->GetRenderProcessHost();
+  int process_id = host ? host->GetID() : -1;
+  if (process_id == process_id_)
+    return;
+  RemoveFromIndex();
+  if (process_id == -1)
+    return;
+  process_id_ = process_id;
+  instances_.insert(std::make_pair(process_id_, this));
+}
+
+void WebContentsPreferences::RemoveFromIndex() {
+  auto range = instances_.equal_range(process_id_);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == this) {
+      instances_.erase(it);
+      break;
+    }
+  }
+  process_id_ = -1;
 }
 
 void WebContentsPreferences::Merge(const base::DictionaryValue& extend) {
@@ -60,10 +95,13 @@ void WebContentsPreferences::Merge(const base::DictionaryValue& extend) {
 // static
 content::WebContents* WebContentsPreferences::GetWebContentsFromProcessID(
     int process_id) {
-  for (WebContentsPreferences* preferences : instances_) {
-    content::WebContents* web_contents = preferences->web_contents_;
-    if (web_contents->GetRenderProcessHost()->GetID() == process_id)
-      return web_contents;
+  // lower_bound() rather than find() so the first WebContents indexed for a
+  // shared process wins.
+  auto it = instances_.lower_bound(process_id);
+  if (it != instances_.end() && it->first == process_id) {
+    content::WebContents* web_contents = it->second->web_contents_;
+    DCHECK_EQ(web_contents->GetRenderProcessHost()->GetID(), process_id);
+    return web_contents;
   }
   // Also try to get the webview from RenderViewHost::FromID because
   // not all web contents have preferences created (devtools).
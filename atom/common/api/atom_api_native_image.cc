@@ -2,6 +2,7 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -9,23 +10,34 @@
 
 #include "atom/common/api/atom_api_native_image.h"
 
+#include "atom/common/api/locker.h"
 #include "atom/common/asar/asar_util.h"
+#include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/gfx_converter.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
 #include "base/base64.h"
 #include "base/files/file_util.h"
+#include "base/lazy_instance.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/sha1.h"
 #include "base/strings/pattern.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/task_scheduler/task_scheduler.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "native_mate/dictionary.h"
 #include "native_mate/object_template_builder.h"
 #include "net/base/data_url.h"
+#include "skia/ext/image_operations.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
 #include "ui/base/layout.h"
 #include "ui/gfx/codec/jpeg_codec.h"
 #include "ui/gfx/codec/png_codec.h"
 #include "ui/gfx/geometry/size.h"
 #include "ui/gfx/image/image_skia.h"
+#include "ui/gfx/image/image_skia_operations.h"
 #include "ui/gfx/image/image_util.h"
 
 #if defined(OS_WIN)
@@ -178,7 +190,235 @@ bool ReadImageSkiaFromICO(gfx::ImageSkia* image, HICON icon) {
 }
 #endif
 
-void Noop(char*, void*) {
+void FreeBitmap(char*, void* hint) {
+  delete static_cast<SkBitmap*>(hint);
+}
+
+void FreeEncodedData(char*, void* hint) {
+  delete static_cast<std::vector<unsigned char>*>(hint);
+}
+
+// At most this many image tasks run on the task scheduler at once.
+const size_t kMaxRunningImageTasks = 4;
+// Requests beyond this are rejected instead of queued.
+const size_t kMaxQueuedImageTasks = 512;
+
+struct ImageTaskResult {
+  ImageTaskResult() : success(false) {}
+
+  bool success;
+  SkBitmap bitmap;
+  std::vector<unsigned char> encoded;
+};
+
+using ImageTask = base::Callback<std::unique_ptr<ImageTaskResult>()>;
+using ImageTaskReply = base::Callback<void(ImageTaskResult*)>;
+using ImageCallback = base::Callback<void(v8::Local<v8::Value>)>;
+
+// Runs image decodes and encodes on the task scheduler with a bounded
+// number of running and queued tasks. Pending requests with the same key
+// share a single task. Only used from the main thread of the process.
+class ImageTaskQueue {
+ public:
+  ImageTaskQueue() : next_id_(1), running_(0) {}
+
+  // Returns the request id, or 0 if the queue is full.
+  int Add(const std::string& key,
+          const ImageTask& task,
+          const ImageTaskReply& reply) {
+    int request_id = next_id_++;
+
+    auto it = key.empty() ? job_for_key_.end() : job_for_key_.find(key);
+    if (it != job_for_key_.end()) {
+      jobs_[it->second].replies[request_id] = reply;
+      job_for_request_[request_id] = it->second;
+      return request_id;
+    }
+
+    if (jobs_.size() - running_ >= kMaxQueuedImageTasks)
+      return 0;
+
+    int job_id = next_id_++;
+    Job& job = jobs_[job_id];
+    job.key = key;
+    job.task = task;
+    job.running = false;
+    job.replies[request_id] = reply;
+    job_for_request_[request_id] = job_id;
+    if (!key.empty())
+      job_for_key_[key] = job_id;
+
+    MaybeStartJobs();
+    return request_id;
+  }
+
+  void Cancel(int request_id) {
+    auto it = job_for_request_.find(request_id);
+    if (it == job_for_request_.end())
+      return;
+
+    int job_id = it->second;
+    job_for_request_.erase(it);
+
+    Job& job = jobs_[job_id];
+    job.replies.erase(request_id);
+    // a running task can't be stopped, its result is dropped when it's done
+    if (job.replies.empty() && !job.running)
+      RemoveJob(job_id);
+  }
+
+ private:
+  struct Job {
+    std::string key;
+    ImageTask task;
+    bool running;
+    std::map<int, ImageTaskReply> replies;
+  };
+
+  void MaybeStartJobs() {
+    for (auto& entry : jobs_) {
+      if (running_ >= kMaxRunningImageTasks)
+        break;
+
+      Job& job = entry.second;
+      if (job.running)
+        continue;
+
+      job.running = true;
+      running_++;
+      auto reply = base::Bind(&ImageTaskQueue::OnJobDone,
+                              base::Unretained(this), entry.first);
+      if (base::TaskScheduler::GetInstance()) {
+        base::PostTaskWithTraitsAndReplyWithResult(
+            FROM_HERE, {base::TaskPriority::USER_VISIBLE}, job.task, reply);
+      } else {
+        // node mode has no task scheduler
+        base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+            base::Bind(reply, base::Passed(job.task.Run())));
+      }
+    }
+  }
+
+  void OnJobDone(int job_id, std::unique_ptr<ImageTaskResult> result) {
+    running_--;
+
+    auto it = jobs_.find(job_id);
+    if (it != jobs_.end()) {
+      std::map<int, ImageTaskReply> replies;
+      replies.swap(it->second.replies);
+      for (const auto& reply : replies)
+        job_for_request_.erase(reply.first);
+      RemoveJob(job_id);
+
+      for (const auto& reply : replies)
+        reply.second.Run(result.get());
+    }
+
+    MaybeStartJobs();
+  }
+
+  void RemoveJob(int job_id) {
+    auto it = jobs_.find(job_id);
+    if (!it->second.key.empty())
+      job_for_key_.erase(it->second.key);
+    jobs_.erase(it);
+  }
+
+  int next_id_;
+  size_t running_;
+  // ordered by id so jobs start in the order they were added
+  std::map<int, Job> jobs_;
+  std::map<std::string, int> job_for_key_;
+  std::map<int, int> job_for_request_;
+
+  DISALLOW_COPY_AND_ASSIGN(ImageTaskQueue);
+};
+
+base::LazyInstance<ImageTaskQueue>::Leaky g_image_task_queue =
+    LAZY_INSTANCE_INITIALIZER;
+
+std::unique_ptr<ImageTaskResult> DecodeImage(
+    scoped_refptr<base::RefCountedString> data) {
+  std::unique_ptr<ImageTaskResult> result(new ImageTaskResult);
+  const unsigned char* bytes = data->front();
+  size_t size = data->size();
+
+  // Try PNG first.
+  if (gfx::PNGCodec::Decode(bytes, size, &result->bitmap)) {
+    result->success = true;
+  } else {
+    // Try JPEG.
+    std::unique_ptr<SkBitmap> decoded = gfx::JPEGCodec::Decode(bytes, size);
+    if (decoded) {
+      result->bitmap = *decoded;
+      result->success = true;
+    }
+  }
+  return result;
+}
+
+std::unique_ptr<ImageTaskResult> EncodeImage(const SkBitmap& bitmap,
+                                             bool png,
+                                             int quality) {
+  std::unique_ptr<ImageTaskResult> result(new ImageTaskResult);
+  SkAutoLockPixels lock(bitmap);
+  if (png) {
+    result->success = gfx::PNGCodec::EncodeBGRASkBitmap(
+        bitmap, false, &result->encoded);
+  } else {
+    result->success = gfx::JPEGCodec::Encode(
+        reinterpret_cast<const unsigned char*>(bitmap.getPixels()),
+        gfx::JPEGCodec::FORMAT_SkBitmap, bitmap.width(), bitmap.height(),
+        static_cast<int>(bitmap.rowBytes()), quality, &result->encoded);
+  }
+  return result;
+}
+
+void OnDecodeDone(v8::Isolate* isolate,
+                  double scale_factor,
+                  const ImageCallback& callback,
+                  ImageTaskResult* result) {
+  mate::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  if (!result || !result->success) {
+    callback.Run(v8::Null(isolate));
+    return;
+  }
+
+  gfx::ImageSkia image_skia(gfx::ImageSkiaRep(result->bitmap, scale_factor));
+  callback.Run(NativeImage::Create(isolate, gfx::Image(image_skia)).ToV8());
+}
+
+void OnEncodeDone(v8::Isolate* isolate,
+                  const ImageCallback& callback,
+                  ImageTaskResult* result) {
+  mate::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  if (!result || !result->success || result->encoded.empty()) {
+    callback.Run(v8::Null(isolate));
+    return;
+  }
+
+  // the result is shared by coalesced requests so each gets its own copy
+  auto encoded = new std::vector<unsigned char>(result->encoded);
+  callback.Run(node::Buffer::New(isolate,
+                                 reinterpret_cast<char*>(encoded->data()),
+                                 encoded->size(),
+                                 &FreeEncodedData,
+                                 encoded).ToLocalChecked());
+}
+
+int PostImageTask(v8::Isolate* isolate,
+                  const std::string& key,
+                  const ImageTask& task,
+                  const ImageTaskReply& reply) {
+  int request_id = g_image_task_queue.Get().Add(key, task, reply);
+  if (!request_id) {
+    // the queue is full
+    base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+        base::Bind(reply, static_cast<ImageTaskResult*>(nullptr)));
+  }
+  return request_id;
 }
 
 }  // namespace
@@ -256,13 +496,75 @@ std::string NativeImage::ToDataURL() {
 }
 
 v8::Local<v8::Value> NativeImage::GetBitmap(v8::Isolate* isolate) {
-  const SkBitmap* bitmap = image_.ToSkBitmap();
+  // The buffer holds a reference to the pixels so it stays valid after the
+  // image is garbage collected.
+  SkBitmap* bitmap = new SkBitmap(*image_.ToSkBitmap());
   SkPixelRef* ref = bitmap->pixelRef();
   return node::Buffer::New(isolate,
                            reinterpret_cast<char*>(ref->pixels()),
                            bitmap->getSafeSize(),
-                           &Noop,
-                           nullptr).ToLocalChecked();
+                           &FreeBitmap,
+                           bitmap).ToLocalChecked();
+}
+
+int NativeImage::ToPNGAsync(mate::Arguments* args) {
+  ImageCallback callback;
+  if (!args->GetNext(&callback)) {
+    args->ThrowError("`callback` is a required field");
+    return 0;
+  }
+
+  return PostImageTask(args->isolate(), std::string(),
+      base::Bind(&EncodeImage, image_.AsBitmap(), true, 0),
+      base::Bind(&OnEncodeDone, args->isolate(), callback));
+}
+
+int NativeImage::ToJPEGAsync(mate::Arguments* args) {
+  int quality = 0;
+  ImageCallback callback;
+  if (!args->GetNext(&quality) || !args->GetNext(&callback)) {
+    args->ThrowError("`quality` and `callback` are required fields");
+    return 0;
+  }
+
+  return PostImageTask(args->isolate(), std::string(),
+      base::Bind(&EncodeImage, image_.AsBitmap(), false, quality),
+      base::Bind(&OnEncodeDone, args->isolate(), callback));
+}
+
+mate::Handle<NativeImage> NativeImage::Resize(
+    v8::Isolate* isolate, const mate::Dictionary& options) {
+  gfx::Size size = GetSize();
+  if (size.IsEmpty())
+    return CreateEmpty(isolate);
+
+  // Keep the aspect ratio when only one dimension is given.
+  int width = size.width();
+  int height = size.height();
+  bool width_set = options.Get("width", &width);
+  bool height_set = options.Get("height", &height);
+  if (width_set && !height_set)
+    height = width * size.height() / size.width();
+  else if (height_set && !width_set)
+    width = height * size.width() / size.height();
+
+  if (width <= 0 || height <= 0)
+    return CreateEmpty(isolate);
+
+  skia::ImageOperations::ResizeMethod method =
+      skia::ImageOperations::RESIZE_BEST;
+  std::string quality;
+  if (options.Get("quality", &quality)) {
+    if (quality == "good")
+      method = skia::ImageOperations::RESIZE_GOOD;
+    else if (quality == "better")
+      method = skia::ImageOperations::RESIZE_BETTER;
+  }
+
+  // The resized representations are only generated when they're used.
+  gfx::ImageSkia resized = gfx::ImageSkiaOperations::CreateResizedImage(
+      image_.AsImageSkia(), method, gfx::Size(width, height));
+  return Create(isolate, gfx::Image(resized));
 }
 
 v8::Local<v8::Value> NativeImage::GetNativeHandle(v8::Isolate* isolate,
@@ -358,6 +660,38 @@ mate::Handle<NativeImage> NativeImage::CreateFromBuffer(
   return Create(args->isolate(), gfx::Image(image_skia));
 }
 
+// static
+int NativeImage::CreateFromBufferAsync(mate::Arguments* args) {
+  v8::Local<v8::Value> buffer;
+  if (!args->GetNext(&buffer) || !node::Buffer::HasInstance(buffer)) {
+    args->ThrowError("`buffer` must be a Buffer");
+    return 0;
+  }
+
+  double scale_factor = 1.;
+  args->GetNext(&scale_factor);
+
+  ImageCallback callback;
+  if (!args->GetNext(&callback)) {
+    args->ThrowError("`callback` is a required field");
+    return 0;
+  }
+
+  // Copy the data because the buffer may be changed while decoding.
+  std::string data(node::Buffer::Data(buffer), node::Buffer::Length(buffer));
+  std::string key = base::SHA1HashString(data);
+  key.append(base::DoubleToString(scale_factor));
+
+  return PostImageTask(args->isolate(), key,
+      base::Bind(&DecodeImage, base::RefCountedString::TakeString(&data)),
+      base::Bind(&OnDecodeDone, args->isolate(), scale_factor, callback));
+}
+
+// static
+void NativeImage::CancelRequest(int request_id) {
+  g_image_task_queue.Get().Cancel(request_id);
+}
+
 // static
 mate::Handle<NativeImage> NativeImage::CreateFromDataURL(
     v8::Isolate* isolate, const GURL& url) {
@@ -379,6 +713,9 @@ void NativeImage::BuildPrototype(
   mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
       .SetMethod("toPNG", &NativeImage::ToPNG)
       .SetMethod("toJPEG", &NativeImage::ToJPEG)
+      .SetMethod("toPNGAsync", &NativeImage::ToPNGAsync)
+      .SetMethod("toJPEGAsync", &NativeImage::ToJPEGAsync)
+      .SetMethod("resize", &NativeImage::Resize)
       .SetMethod("toBitmap", &NativeImage::ToBitmap)
       .SetMethod("getBitmap", &NativeImage::GetBitmap)
       .SetMethod("getNativeHandle", &NativeImage::GetNativeHandle)
@@ -434,6 +771,9 @@ void Initialize(v8::Local<v8::Object> exports, v8::Local<v8::Value> unused,
   dict.SetMethod("createEmpty", &atom::api::NativeImage::CreateEmpty);
   dict.SetMethod("createFromPath", &atom::api::NativeImage::CreateFromPath);
   dict.SetMethod("createFromBuffer", &atom::api::NativeImage::CreateFromBuffer);
+  dict.SetMethod("createFromBufferAsync",
+                 &atom::api::NativeImage::CreateFromBufferAsync);
+  dict.SetMethod("cancelRequest", &atom::api::NativeImage::CancelRequest);
   dict.SetMethod("createFromDataURL",
                  &atom::api::NativeImage::CreateFromDataURL);
 }
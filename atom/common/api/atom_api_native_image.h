@@ -29,6 +29,7 @@ class Size;
 
 namespace mate {
 class Arguments;
+class Dictionary;
 }
 
 namespace atom {
@@ -51,6 +52,12 @@ class NativeImage : public mate::Wrappable<NativeImage> {
   static mate::Handle<NativeImage> CreateFromDataURL(
       v8::Isolate* isolate, const GURL& url);
 
+  // Decodes |buffer| off the main thread and calls |callback| with the
+  // image, or null if the data can't be decoded or too many requests are
+  // pending. Returns an id that can be passed to CancelRequest.
+  static int CreateFromBufferAsync(mate::Arguments* args);
+  static void CancelRequest(int request_id);
+
   static void BuildPrototype(v8::Isolate* isolate,
                              v8::Local<v8::FunctionTemplate> prototype);
 
@@ -70,6 +77,10 @@ class NativeImage : public mate::Wrappable<NativeImage> {
  private:
   v8::Local<v8::Value> ToPNG(v8::Isolate* isolate);
   v8::Local<v8::Value> ToJPEG(v8::Isolate* isolate, int quality);
+  int ToPNGAsync(mate::Arguments* args);
+  int ToJPEGAsync(mate::Arguments* args);
+  mate::Handle<NativeImage> Resize(v8::Isolate* isolate,
+                                   const mate::Dictionary& options);
   v8::Local<v8::Value> ToBitmap(v8::Isolate* isolate);
   v8::Local<v8::Value> GetBitmap(v8::Isolate* isolate);
   v8::Local<v8::Value> GetNativeHandle(
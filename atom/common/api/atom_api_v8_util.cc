@@ -2,6 +2,8 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <iterator>
 #include <string>
 #include <utility>
 
@@ -88,6 +90,77 @@ int32_t GetObjectHash(v8::Local<v8::Object> object) {
   return object->GetIdentityHash();
 }
 
+// Returns the descriptors of |object|'s own members, this matches
+// |setObjectMembers| in the renderer's remote module.
+v8::Local<v8::Value> GetObjectMembers(v8::Isolate* isolate,
+                                      v8::Local<v8::Object> object) {
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::Array> result = v8::Array::New(isolate);
+
+  v8::Local<v8::Array> names;
+  if (!object->GetOwnPropertyNames(context, v8::SKIP_SYMBOLS).ToLocal(&names))
+    return result;
+
+  // For Function, we should not override following properties even though
+  // they are "own" properties.
+  static const char* const kFunctionProperties[] = {
+    "length", "name", "arguments", "caller", "prototype"
+  };
+  bool is_function = object->IsFunction();
+
+  v8::Local<v8::String> get_key = mate::StringToV8(isolate, "get");
+  v8::Local<v8::String> set_key = mate::StringToV8(isolate, "set");
+  v8::Local<v8::String> writable_key = mate::StringToV8(isolate, "writable");
+  v8::Local<v8::String> enumerable_key =
+      mate::StringToV8(isolate, "enumerable");
+
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < names->Length(); ++i) {
+    v8::Local<v8::String> name;
+    if (!names->Get(context, i).ToLocalChecked()->ToString(context)
+            .ToLocal(&name))
+      continue;
+
+    if (is_function) {
+      std::string name_str = mate::V8ToString(name);
+      if (std::find(std::begin(kFunctionProperties),
+                    std::end(kFunctionProperties),
+                    name_str) != std::end(kFunctionProperties))
+        continue;
+    }
+
+    v8::Local<v8::Value> value;
+    if (!object->GetOwnPropertyDescriptor(context, name).ToLocal(&value) ||
+        !value->IsObject())
+      continue;
+    v8::Local<v8::Object> descriptor = value.As<v8::Object>();
+
+    v8::Local<v8::Value> getter, setter, writable, enumerable;
+    if (!descriptor->Get(context, get_key).ToLocal(&getter) ||
+        !descriptor->Get(context, set_key).ToLocal(&setter) ||
+        !descriptor->Get(context, writable_key).ToLocal(&writable) ||
+        !descriptor->Get(context, enumerable_key).ToLocal(&enumerable))
+      continue;
+
+    mate::Dictionary member = mate::Dictionary::CreateEmpty(isolate);
+    member.Set("name", name);
+    member.Set("enumerable", enumerable->BooleanValue());
+    v8::Local<v8::Value> member_value;
+    if (getter->IsUndefined() &&
+        object->Get(context, name).ToLocal(&member_value) &&
+        member_value->IsFunction()) {
+      member.Set("type", "method");
+      member.Set("writable", false);
+    } else {
+      member.Set("type", "get");
+      member.Set("writable",
+                 !setter->IsUndefined() || writable->BooleanValue());
+    }
+    result->Set(context, count++, member.GetHandle()).FromJust();
+  }
+  return result;
+}
+
 void TakeHeapSnapshot(v8::Isolate* isolate) {
   isolate->GetHeapProfiler()->TakeHeapSnapshot();
 }
@@ -99,6 +172,7 @@ void Initialize(v8::Local<v8::Object> exports, v8::Local<v8::Value> unused,
   dict.SetMethod("setHiddenValue", &SetHiddenValue);
   dict.SetMethod("deleteHiddenValue", &DeleteHiddenValue);
   dict.SetMethod("getObjectHash", &GetObjectHash);
+  dict.SetMethod("getObjectMembers", &GetObjectMembers);
   dict.SetMethod("takeHeapSnapshot", &TakeHeapSnapshot);
   dict.SetMethod("setRemoteCallbackFreer", &atom::RemoteCallbackFreer::BindTo);
   dict.SetMethod("setRemoteObjectFreer", &atom::RemoteObjectFreer::BindTo);
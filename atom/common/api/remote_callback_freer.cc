@@ -4,12 +4,71 @@
 
 #include "atom/common/api/remote_callback_freer.h"
 
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "atom/common/api/api_messages.h"
+#include "base/bind.h"
+#include "base/lazy_instance.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/values.h"
 
 namespace atom {
 
+namespace {
+
+// Ids of the callbacks released in a WebContents since the last flush.
+class PendingCallbackReleases : public content::WebContentsObserver {
+ public:
+  explicit PendingCallbackReleases(content::WebContents* web_contents)
+      : content::WebContentsObserver(web_contents) {}
+
+  void Add(int object_id) { ids_.push_back(object_id); }
+
+  void Flush() {
+    base::string16 channel =
+        base::ASCIIToUTF16("ELECTRON_RENDERER_RELEASE_CALLBACK");
+    std::unique_ptr<base::ListValue> ids(new base::ListValue);
+    for (int id : ids_)
+      ids->AppendInteger(id);
+
+    base::ListValue args;
+    args.Append(std::move(ids));
+    Send(new AtomViewMsg_Message(routing_id(), false, channel, args));
+  }
+
+  // content::WebContentsObserver:
+  void WebContentsDestroyed() override;
+
+ private:
+  std::vector<int> ids_;
+
+  DISALLOW_COPY_AND_ASSIGN(PendingCallbackReleases);
+};
+
+base::LazyInstance<std::map<content::WebContents*, PendingCallbackReleases*>>
+    ::Leaky g_pending_releases = LAZY_INSTANCE_INITIALIZER;
+
+void PendingCallbackReleases::WebContentsDestroyed() {
+  g_pending_releases.Get().erase(web_contents());
+  delete this;
+}
+
+void FlushPendingReleases() {
+  std::map<content::WebContents*, PendingCallbackReleases*> pending;
+  pending.swap(g_pending_releases.Get());
+
+  for (const auto& entry : pending) {
+    entry.second->Flush();
+    delete entry.second;
+  }
+}
+
+}  // namespace
+
 // static
 void RemoteCallbackFreer::BindTo(v8::Isolate* isolate,
                                  v8::Local<v8::Object> target,
@@ -31,11 +90,18 @@ RemoteCallbackFreer::~RemoteCallbackFreer() {
 }
 
 void RemoteCallbackFreer::RunDestructor() {
-  base::string16 channel =
-      base::ASCIIToUTF16("ELECTRON_RENDERER_RELEASE_CALLBACK");
-  base::ListValue args;
-  args.AppendInteger(object_id_);
-  Send(new AtomViewMsg_Message(routing_id(), false, channel, args));
+  if (web_contents()) {
+    // Callbacks collected in the same GC are released with a single message.
+    auto& pending = g_pending_releases.Get();
+    if (pending.empty()) {
+      base::ThreadTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE, base::Bind(&FlushPendingReleases));
+    }
+    PendingCallbackReleases*& releases = pending[web_contents()];
+    if (!releases)
+      releases = new PendingCallbackReleases(web_contents());
+    releases->Add(object_id_);
+  }
 
   Observe(nullptr);
 }
@@ -4,8 +4,16 @@
 
 #include "atom/common/api/remote_object_freer.h"
 
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "atom/common/api/api_messages.h"
+#include "base/bind.h"
+#include "base/lazy_instance.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/values.h"
 #include "content/public/renderer/render_view.h"
 #include "third_party/WebKit/public/web/WebLocalFrame.h"
@@ -30,6 +38,33 @@ content::RenderView* GetCurrentRenderView() {
   return content::RenderView::FromWebView(view);
 }
 
+// Ids of the objects released since the last flush, by render view.
+base::LazyInstance<std::map<int, std::vector<int>>>::Leaky
+    g_pending_releases = LAZY_INSTANCE_INITIALIZER;
+
+void FlushPendingReleases() {
+  std::map<int, std::vector<int>> pending;
+  pending.swap(g_pending_releases.Get());
+
+  base::string16 channel = base::ASCIIToUTF16("ipc-message");
+  for (const auto& entry : pending) {
+    content::RenderView* render_view =
+        content::RenderView::FromRoutingID(entry.first);
+    if (!render_view)
+      continue;
+
+    std::unique_ptr<base::ListValue> ids(new base::ListValue);
+    for (int id : entry.second)
+      ids->AppendInteger(id);
+
+    base::ListValue args;
+    args.AppendString("ELECTRON_BROWSER_DEREFERENCE");
+    args.Append(std::move(ids));
+    render_view->Send(
+        new AtomViewHostMsg_Message(entry.first, channel, args));
+  }
+}
+
 }  // namespace
 
 // static
@@ -53,17 +88,16 @@ RemoteObjectFreer::~RemoteObjectFreer() {
 }
 
 void RemoteObjectFreer::RunDestructor() {
-  content::RenderView* render_view =
-      content::RenderView::FromRoutingID(routing_id_);
-  if (!render_view)
+  if (routing_id_ == MSG_ROUTING_NONE)
     return;
 
-  base::string16 channel = base::ASCIIToUTF16("ipc-message");
-  base::ListValue args;
-  args.AppendString("ELECTRON_BROWSER_DEREFERENCE");
-  args.AppendInteger(object_id_);
-  render_view->Send(
-      new AtomViewHostMsg_Message(render_view->GetRoutingID(), channel, args));
+  // Objects collected in the same GC are released with a single message.
+  auto& pending = g_pending_releases.Get();
+  if (pending.empty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::Bind(&FlushPendingReleases));
+  }
+  pending[routing_id_].push_back(object_id_);
 }
 
 }  // namespace atom
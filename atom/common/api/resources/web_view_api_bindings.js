@@ -116,8 +116,15 @@ WebViewImpl.prototype.attachGuest = function (guestInstanceId) {
 }
 
 WebViewImpl.prototype.setTabId = function (tabID) {
+  if (this.tabID === tabID)
+    return
+
+  // Stop dispatching the events of the tab this view showed before, another
+  // view may show it now.
+  if (this.unregisterEvents_)
+    this.unregisterEvents_()
   this.tabID = tabID
-  GuestViewInternal.registerEvents(this, tabID)
+  this.unregisterEvents_ = GuestViewInternal.registerEvents(this, tabID)
 }
 
 WebViewImpl.prototype.getId = function () {
@@ -15,6 +15,7 @@
 #include "base/logging.h"
 #include "base/pickle.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 
 #if defined(OS_WIN)
@@ -143,6 +144,8 @@ Archive::~Archive() {
 }
 
 bool Archive::Init() {
+  TRACE_EVENT1("electron.asar", "Archive::Init",
+               "path", path_.AsUTF8Unsafe());
   if (!file_.IsValid()) {
     if (file_.error_details() != base::File::FILE_ERROR_NOT_FOUND) {
       LOG(WARNING) << "Opening " << path_.value()
@@ -273,6 +276,8 @@ bool Archive::Realpath(const base::FilePath& path, base::FilePath* realpath) {
 }
 
 bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
+  TRACE_EVENT1("electron.asar", "Archive::CopyFileOut",
+               "path", path.AsUTF8Unsafe());
   auto it = external_files_.find(path.value());
   if (it != external_files_.end()) {
     *out = it->second->path();
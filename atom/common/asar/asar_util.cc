@@ -12,6 +12,7 @@
 #include "base/files/file_util.h"
 #include "base/lazy_instance.h"
 #include "base/stl_util.h"
+#include "base/trace_event/trace_event.h"
 
 namespace asar {
 
@@ -60,6 +61,8 @@ bool GetAsarArchivePath(const base::FilePath& full_path,
 }
 
 bool ReadFileToString(const base::FilePath& path, std::string* contents) {
+  TRACE_EVENT1("electron.asar", "asar::ReadFileToString",
+               "path", path.AsUTF8Unsafe());
   base::FilePath asar_path, relative_path;
   if (!GetAsarArchivePath(path, &asar_path, &relative_path))
     return base::ReadFileToString(path, contents);
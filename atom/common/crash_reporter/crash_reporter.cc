@@ -14,7 +14,7 @@
 
 namespace crash_reporter {
 
-CrashReporter::CrashReporter() {
+CrashReporter::CrashReporter() : upload_to_spool_(false) {
   auto cmd = base::CommandLine::ForCurrentProcess();
   is_browser_ = cmd->GetSwitchValueASCII(switches::kProcessType).empty();
 }
@@ -34,6 +34,10 @@ void CrashReporter::Start(const std::string& product_name,
                auto_submit, skip_system_crash_handler);
 }
 
+void CrashReporter::SetUploadToSpool(bool upload_to_spool) {
+  upload_to_spool_ = upload_to_spool;
+}
+
 void CrashReporter::SetUploadParameters(const StringMap& parameters) {
   upload_parameters_ = parameters;
   upload_parameters_["process_type"] = is_browser_ ? "browser" : "renderer";
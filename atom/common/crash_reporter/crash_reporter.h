@@ -31,6 +31,11 @@ class CrashReporter {
   virtual std::vector<CrashReporter::UploadReportResult> GetUploadedReports(
       const std::string& path);
 
+  // Leave the reports in the crash directory for the browser process to
+  // upload later instead of uploading them from the crashed process. Only
+  // used on Linux.
+  void SetUploadToSpool(bool upload_to_spool);
+
  protected:
   CrashReporter();
   virtual ~CrashReporter();
@@ -45,6 +50,7 @@ class CrashReporter {
 
   StringMap upload_parameters_;
   bool is_browser_;
+  bool upload_to_spool_;
 
  private:
   void SetUploadParameters(const StringMap& parameters);
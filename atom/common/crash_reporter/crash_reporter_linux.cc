@@ -119,7 +119,9 @@ bool CrashReporterLinux::CrashDone(const MinidumpDescriptor& minidump,
   info.fd = minidump.fd();
   info.distro = base::g_linux_distro;
   info.distro_length = my_strlen(base::g_linux_distro);
-  info.upload = true;
+  // Without uploading, the report is written over the minidump and left for
+  // the browser process to upload.
+  info.upload = !self->upload_to_spool_;
   info.process_start_time = self->process_start_time_;
   info.oom_size = base::g_oom_size;
   info.pid = self->pid_;
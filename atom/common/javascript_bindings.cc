@@ -12,6 +12,8 @@
 #include "atom/common/native_mate_converters/content_converter.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/common/extensions/shared_memory_bindings.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_view.h"
@@ -128,6 +130,8 @@ void JavascriptBindings::DeleteHiddenValue(v8::Isolate* isolate,
 void JavascriptBindings::IPCSend(mate::Arguments* args,
           const base::string16& channel,
           const base::ListValue& arguments) {
+  TRACE_EVENT1("electron.ipc", "JavascriptBindings::IPCSend",
+               "channel", base::UTF16ToUTF8(channel));
   if (!is_valid() || !render_view())
     return;
 
@@ -141,6 +145,8 @@ void JavascriptBindings::IPCSend(mate::Arguments* args,
 base::string16 JavascriptBindings::IPCSendSync(mate::Arguments* args,
                         const base::string16& channel,
                         const base::ListValue& arguments) {
+  TRACE_EVENT1("electron.ipc", "JavascriptBindings::IPCSendSync",
+               "channel", base::UTF16ToUTF8(channel));
   base::string16 json;
 
   if (!is_valid() || !render_view()) {
@@ -256,6 +262,8 @@ void JavascriptBindings::OnSharedBrowserMessage(const base::string16& channel,
 void JavascriptBindings::OnBrowserMessage(bool all_frames,
                                           const base::string16& channel,
                                           const base::ListValue& args) {
+  TRACE_EVENT1("electron.ipc", "JavascriptBindings::OnBrowserMessage",
+               "channel", base::UTF16ToUTF8(channel));
   if (!is_valid())
     return;
 
@@ -18,6 +18,7 @@
 #include "base/files/file_path.h"
 #include "base/message_loop/message_loop.h"
 #include "base/path_service.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/common/content_paths.h"
 #include "gin/public/v8_platform.h"
@@ -38,6 +39,7 @@ REFERENCE_MODULE(atom_browser_app);
 REFERENCE_MODULE(atom_browser_auto_updater);
 REFERENCE_MODULE(atom_browser_component_updater);
 REFERENCE_MODULE(atom_browser_content_tracing);
+REFERENCE_MODULE(atom_browser_crash_report_uploader);
 REFERENCE_MODULE(atom_browser_dialog);
 REFERENCE_MODULE(atom_browser_debugger);
 #if defined(ENABLE_WEBRTC)
@@ -130,8 +132,10 @@ base::FilePath GetResourcesPath() {
 NodeBindings::NodeBindings()
     : message_loop_(nullptr),
       uv_loop_(uv_default_loop()),
+      use_embed_thread_(true),
       embed_closed_(false),
       uv_env_(nullptr),
+      wakeup_count_(0),
       weak_factory_(this) {
 }
 
@@ -139,7 +143,7 @@ NodeBindings::~NodeBindings() {
   // Quit the embed thread.
   embed_closed_ = true;
   // node never started
-  if (!uv_env_)
+  if (!uv_env_ || !use_embed_thread_)
     return;
   uv_sem_post(&embed_sem_);
   WakeupEmbedThread();
@@ -171,6 +175,7 @@ void NodeBindings::Initialize() {
 
 node::Environment* NodeBindings::CreateEnvironment(
     v8::Handle<v8::Context> context) {
+  TRACE_EVENT0("electron.startup", "NodeBindings::CreateEnvironment");
   auto args = AtomCommandLine::argv_utf8();
 
   // Feed node the path to initialization script.
@@ -199,6 +204,11 @@ node::Environment* NodeBindings::CreateEnvironment(
   PathService::Get(content::CHILD_PROCESS_EXE, &helper_exec_path);
   process.Set("helperExecPath", helper_exec_path);
 
+  // The bindings outlive the environment.
+  process.SetMethod("getUvWakeupStats",
+                    base::Bind(&NodeBindings::GetWakeupStats,
+                               base::Unretained(this)));
+
   // Set process._debugWaitConnect if --debug-brk was specified to stop
   // the debugger on the first line
   if (base::CommandLine::ForCurrentProcess()->HasSwitch("debug-brk"))
@@ -219,6 +229,7 @@ node::Environment* NodeBindings::CreateEnvironment(
 }
 
 void NodeBindings::LoadEnvironment(node::Environment* env) {
+  TRACE_EVENT0("electron.startup", "NodeBindings::LoadEnvironment");
   node::LoadEnvironment(env);
   mate::EmitEvent(env->isolate(), env->process_object(), "loaded");
 }
@@ -230,6 +241,9 @@ void NodeBindings::PrepareMessageLoop() {
   // nothing to do.
   uv_async_init(uv_loop_, &dummy_uv_handle_, nullptr);
 
+  if (!use_embed_thread_)
+    return;
+
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
@@ -267,15 +281,40 @@ void NodeBindings::UvRunOnce() {
     message_loop_->QuitWhenIdle();  // Quit from uv.
 
   // Tell the worker thread to continue polling.
-  uv_sem_post(&embed_sem_);
+  if (use_embed_thread_)
+    uv_sem_post(&embed_sem_);
 }
 
 void NodeBindings::WakeupMainThread() {
   DCHECK(message_loop_);
   message_loop_->task_runner()->PostTask(
       FROM_HERE,
-      base::Bind(&NodeBindings::UvRunOnce,
-      weak_factory_.GetWeakPtr()));
+      base::Bind(&NodeBindings::OnMainThreadWakeup,
+                 weak_factory_.GetWeakPtr(),
+                 base::TimeTicks::Now()));
+}
+
+void NodeBindings::OnMainThreadWakeup(base::TimeTicks ready_time) {
+  RecordWakeup(ready_time);
+  UvRunOnce();
+}
+
+void NodeBindings::RecordWakeup(base::TimeTicks ready_time) {
+  base::TimeDelta latency = base::TimeTicks::Now() - ready_time;
+  wakeup_count_++;
+  total_wakeup_latency_ += latency;
+  if (latency > max_wakeup_latency_)
+    max_wakeup_latency_ = latency;
+}
+
+v8::Local<v8::Value> NodeBindings::GetWakeupStats(v8::Isolate* isolate) {
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("embedThread", use_embed_thread_);
+  dict.Set("wakeups", static_cast<double>(wakeup_count_));
+  dict.Set("averageLatency", wakeup_count_ ?
+      total_wakeup_latency_.InMillisecondsF() / wakeup_count_ : 0.);
+  dict.Set("maxLatency", max_wakeup_latency_.InMillisecondsF());
+  return dict.GetHandle();
 }
 
 void NodeBindings::WakeupEmbedThread() {
@@ -7,6 +7,7 @@
 
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "v8/include/v8.h"
 #include "vendor/node/deps/uv/include/uv.h"
 
@@ -45,6 +46,10 @@ class NodeBindings {
   void set_uv_env(node::Environment* env) { uv_env_ = env; }
   node::Environment* uv_env() const { return uv_env_; }
 
+  // Returns the number of times the main thread was woken up for uv events
+  // and the latency between the wakeup and running the uv callbacks.
+  v8::Local<v8::Value> GetWakeupStats(v8::Isolate* isolate);
+
  protected:
   NodeBindings();
 
@@ -60,16 +65,26 @@ class NodeBindings {
   // Interrupt the PollEvents.
   void WakeupEmbedThread();
 
+  // Record a wakeup for uv events that were ready at |ready_time|.
+  void RecordWakeup(base::TimeTicks ready_time);
+
   // Main thread's MessageLoop.
   base::MessageLoop* message_loop_;
 
   // Main thread's libuv loop.
   uv_loop_t* uv_loop_;
 
+  // Whether uv events are polled in the embed thread, derived classes that
+  // watch the uv backend fd from the main thread's message pump clear it.
+  bool use_embed_thread_;
+
  private:
   // Thread to poll uv events.
   static void EmbedThreadRunner(void *arg);
 
+  // Run the libuv loop after being woken up by the embed thread.
+  void OnMainThreadWakeup(base::TimeTicks ready_time);
+
   // Whether the libuv loop has ended.
   bool embed_closed_;
 
@@ -85,6 +100,11 @@ class NodeBindings {
   // Environment that to wrap the uv loop.
   node::Environment* uv_env_;
 
+  // Wakeup statistics.
+  uint64_t wakeup_count_;
+  base::TimeDelta total_wakeup_latency_;
+  base::TimeDelta max_wakeup_latency_;
+
   base::WeakPtrFactory<NodeBindings> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(NodeBindings);
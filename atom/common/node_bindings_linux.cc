@@ -6,11 +6,57 @@
 
 #include <sys/epoll.h>
 
+#include "atom/common/options_switches.h"
+#include "base/command_line.h"
+
 namespace atom {
 
+#if defined(USE_GLIB)
+namespace {
+
+struct UvSource {
+  GSource source;
+  NodeBindingsLinux* bindings;
+};
+
+gboolean UvSourcePrepare(GSource* source, gint* timeout_ms) {
+  return reinterpret_cast<UvSource*>(source)->bindings->HandlePrepare(
+      timeout_ms);
+}
+
+gboolean UvSourceCheck(GSource* source) {
+  return reinterpret_cast<UvSource*>(source)->bindings->HandleCheck();
+}
+
+gboolean UvSourceDispatch(GSource* source,
+                          GSourceFunc unused_func,
+                          gpointer unused_data) {
+  reinterpret_cast<UvSource*>(source)->bindings->HandleDispatch();
+  return TRUE;
+}
+
+GSourceFuncs g_uv_source_funcs = {
+  UvSourcePrepare,
+  UvSourceCheck,
+  UvSourceDispatch,
+  nullptr
+};
+
+}  // namespace
+#endif
+
 NodeBindingsLinux::NodeBindingsLinux()
     : NodeBindings(),
       epoll_(epoll_create(1)) {
+#if defined(USE_GLIB)
+  uv_source_ = nullptr;
+  uv_run_pending_ = false;
+  // Let the UI message pump watch uv's backend fd instead of waking it up
+  // from the embed thread.
+  use_embed_thread_ = !base::CommandLine::ForCurrentProcess()->HasSwitch(
+      switches::kNodeMainPump);
+#endif
+
   int backend_fd = uv_backend_fd(uv_loop_);
   struct epoll_event ev = { 0 };
   ev.events = EPOLLIN;
@@ -19,6 +65,12 @@ NodeBindingsLinux::NodeBindingsLinux()
 }
 
 NodeBindingsLinux::~NodeBindingsLinux() {
+#if defined(USE_GLIB)
+  if (uv_source_) {
+    g_source_destroy(uv_source_);
+    g_source_unref(uv_source_);
+  }
+#endif
 }
 
 void NodeBindingsLinux::RunMessageLoop() {
@@ -26,13 +78,71 @@ void NodeBindingsLinux::RunMessageLoop() {
   uv_loop_->data = this;
   uv_loop_->on_watcher_queue_updated = OnWatcherQueueChanged;
 
+#if defined(USE_GLIB)
+  if (!use_embed_thread_) {
+    uv_source_ = g_source_new(&g_uv_source_funcs, sizeof(UvSource));
+    reinterpret_cast<UvSource*>(uv_source_)->bindings = this;
+    uv_poll_fd_.fd = uv_backend_fd(uv_loop_);
+    uv_poll_fd_.events = G_IO_IN;
+    uv_poll_fd_.revents = 0;
+    g_source_add_poll(uv_source_, &uv_poll_fd_);
+    // uv_run is not reentrant, so a run loop nested in a uv callback (e.g. a
+    // modal dialog) must not dispatch the source again. This matches the
+    // embed thread, which waits for UvRunOnce to return before polling.
+    g_source_set_can_recurse(uv_source_, FALSE);
+    g_source_attach(uv_source_, g_main_context_default());
+  }
+#endif
+
   NodeBindings::RunMessageLoop();
 }
 
+#if defined(USE_GLIB)
+bool NodeBindingsLinux::HandlePrepare(gint* timeout_ms) {
+  if (uv_run_pending_) {
+    *timeout_ms = 0;
+    return true;
+  }
+
+  int timeout = uv_backend_timeout(uv_loop_);
+  uv_timer_deadline_ = timeout < 0 ? base::TimeTicks() :
+      base::TimeTicks::Now() + base::TimeDelta::FromMilliseconds(timeout);
+  *timeout_ms = timeout;
+  return timeout == 0;
+}
+
+bool NodeBindingsLinux::HandleCheck() {
+  bool ready = uv_run_pending_ || (uv_poll_fd_.revents & G_IO_IN) ||
+      (!uv_timer_deadline_.is_null() &&
+       base::TimeTicks::Now() >= uv_timer_deadline_);
+  if (ready && uv_ready_time_.is_null())
+    uv_ready_time_ = base::TimeTicks::Now();
+  return ready;
+}
+
+void NodeBindingsLinux::HandleDispatch() {
+  // Watchers added by the callbacks will be picked up by this run.
+  uv_run_pending_ = false;
+  if (!uv_ready_time_.is_null())
+    RecordWakeup(uv_ready_time_);
+  uv_ready_time_ = base::TimeTicks();
+  UvRunOnce();
+}
+#endif
+
 // static
 void NodeBindingsLinux::OnWatcherQueueChanged(uv_loop_t* loop) {
   NodeBindingsLinux* self = static_cast<NodeBindingsLinux*>(loop->data);
 
+#if defined(USE_GLIB)
+  // The new watchers are only added to the backend fd when uv runs, which
+  // happens on this thread, so just make sure it runs soon.
+  if (!self->use_embed_thread_) {
+    self->uv_run_pending_ = true;
+    return;
+  }
+#endif
+
   // We need to break the io polling in the epoll thread when loop's watcher
   // queue changes, otherwise new events cannot be notified.
   self->WakeupEmbedThread();
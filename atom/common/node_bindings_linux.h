@@ -8,6 +8,10 @@
 #include "atom/common/node_bindings.h"
 #include "base/compiler_specific.h"
 
+#if defined(USE_GLIB)
+#include <glib.h>
+#endif
+
 namespace atom {
 
 class NodeBindingsLinux : public NodeBindings {
@@ -17,6 +21,13 @@ class NodeBindingsLinux : public NodeBindings {
 
   void RunMessageLoop() override;
 
+#if defined(USE_GLIB)
+  // Called by the glib source that watches uv's backend fd.
+  bool HandlePrepare(gint* timeout_ms);
+  bool HandleCheck();
+  void HandleDispatch();
+#endif
+
  private:
   // Called when uv's watcher queue changes.
   static void OnWatcherQueueChanged(uv_loop_t* loop);
@@ -26,6 +37,23 @@ class NodeBindingsLinux : public NodeBindings {
   // Epoll to poll for uv's backend fd.
   int epoll_;
 
+#if defined(USE_GLIB)
+  // Source in the main thread's glib context, only used when uv events are
+  // not polled in the embed thread.
+  GSource* uv_source_;
+  GPollFD uv_poll_fd_;
+
+  // Whether uv needs to run without waiting for events, e.g. to register
+  // new watchers with the backend fd.
+  bool uv_run_pending_;
+
+  // When the next uv timer is due, null if there is none.
+  base::TimeTicks uv_timer_deadline_;
+
+  // When the source was found ready in HandleCheck.
+  base::TimeTicks uv_ready_time_;
+#endif
+
   DISALLOW_COPY_AND_ASSIGN(NodeBindingsLinux);
 };
 
@@ -124,6 +124,9 @@ const char kCipherSuiteBlacklist[] = "cipher-suite-blacklist";
 // The browser process app model ID
 const char kAppUserModelId[] = "app-user-model-id";
 
+// Run node's event loop from the main thread's message pump (Linux only).
+const char kNodeMainPump[] = "node-main-pump";
+
 // The command line switch versions of the options.
 const char kBackgroundColor[] = "background-color";
 const char kZoomFactor[]      = "zoom-factor";
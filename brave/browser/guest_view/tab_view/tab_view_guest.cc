@@ -223,7 +223,29 @@ void TabViewGuest::TabIdChanged() {
       "webViewInternal.onTabIdChanged", std::move(args)));
 }
 
+std::unique_ptr<base::DictionaryValue> TabViewGuest::GetTimings() const {
+  const struct {
+    const char* name;
+    base::TimeTicks time;
+  } steps[] = {
+    {"initialized", initialize_time_},
+    {"willAttach", will_attach_time_},
+    {"didAttach", did_attach_time_},
+    {"ready", ready_time_},
+  };
+
+  std::unique_ptr<base::DictionaryValue> timings(new base::DictionaryValue);
+  for (const auto& step : steps) {
+    if (!step.time.is_null())
+      timings->SetDouble(step.name,
+                         (step.time - create_time_).InMillisecondsF());
+  }
+  return timings;
+}
+
 void TabViewGuest::DidInitialize(const base::DictionaryValue& create_params) {
+  initialize_time_ = base::TimeTicks::Now();
+
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
   v8::Locker locker(isolate);
   v8::HandleScope handle_scope(isolate);
@@ -320,6 +342,7 @@ void TabViewGuest::ApplyAttributes(const base::DictionaryValue& params) {
 
 void TabViewGuest::DidAttachToEmbedder() {
   DCHECK(api_web_contents_);
+  did_attach_time_ = base::TimeTicks::Now();
 
   web_contents()->GetMainFrame()->ResumeBlockedRequestsForFrame();
   auto tab_helper = extensions::TabHelper::FromWebContents(web_contents());
@@ -368,6 +391,7 @@ int TabViewGuest::GetTaskPrefix() const {
 void TabViewGuest::GuestReady() {
   // we don't use guest only processes and don't want those limitations
   CHECK(!web_contents()->GetRenderProcessHost()->IsForGuestsOnly());
+  ready_time_ = base::TimeTicks::Now();
 
   web_contents()
       ->GetRenderViewHost()
@@ -404,7 +428,8 @@ TabViewGuest::TabViewGuest(WebContents* owner_web_contents)
     : GuestView<TabViewGuest>(owner_web_contents),
       api_web_contents_(nullptr),
       clone_(false),
-      can_run_detached_(true) {
+      can_run_detached_(true),
+      create_time_(base::TimeTicks::Now()) {
 }
 
 TabViewGuest::~TabViewGuest() {
@@ -412,6 +437,7 @@ TabViewGuest::~TabViewGuest() {
 
 void TabViewGuest::WillAttachToEmbedder() {
   DCHECK(api_web_contents_);
+  will_attach_time_ = base::TimeTicks::Now();
   api_web_contents_->Emit("will-attach", owner_web_contents());
 
   // update the owner window
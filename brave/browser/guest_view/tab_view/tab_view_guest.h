@@ -8,9 +8,11 @@
 #include <stdint.h>
 
 #include <map>
+#include <memory>
 #include <string>
 
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "components/guest_view/browser/guest_view.h"
 
 namespace atom {
@@ -34,6 +36,10 @@ class TabViewGuest : public guest_view::GuestView<TabViewGuest> {
 
   void Load();
 
+  // Milliseconds from the creation of the guest to each step of setting it up
+  // that has happened, the attach steps are the ones of the last attach.
+  std::unique_ptr<base::DictionaryValue> GetTimings() const;
+
  private:
   explicit TabViewGuest(content::WebContents* owner_web_contents);
 
@@ -109,6 +115,12 @@ class TabViewGuest : public guest_view::GuestView<TabViewGuest> {
   using PendingWindowMap = std::map<TabViewGuest*, NewWindowInfo>;
   PendingWindowMap pending_new_windows_;
 
+  base::TimeTicks create_time_;
+  base::TimeTicks initialize_time_;
+  base::TimeTicks will_attach_time_;
+  base::TimeTicks did_attach_time_;
+  base::TimeTicks ready_time_;
+
   DISALLOW_COPY_AND_ASSIGN(TabViewGuest);
 };
 
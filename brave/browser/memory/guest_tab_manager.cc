@@ -4,13 +4,27 @@
 
 #include "brave/browser/memory/guest_tab_manager.h"
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "atom/browser/extensions/tab_helper.h"
+#include "base/bind.h"
+#include "base/process/process_metrics.h"
 #include "brave/browser/guest_view/tab_view/tab_view_guest.h"
 #include "chrome/browser/profiles/profile.h"
+#include "chrome/browser/ui/tab_contents/tab_contents_iterator.h"
 #include "chrome/browser/ui/tabs/tab_strip_model.h"
 #include "content/browser/frame_host/navigation_controller_impl.h"
 #include "content/browser/web_contents/web_contents_impl.h"
 #include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_process_host.h"
+
+#if defined(OS_MACOSX)
+#include "content/public/browser/browser_child_process_host.h"
+#endif
 
 using content::BrowserThread;
 using content::WebContents;
@@ -18,7 +32,8 @@ using content::WebContents;
 namespace content {
 
 RestoreHelper::RestoreHelper(WebContents* contents)
-    : WebContentsObserver(contents) {}
+    : WebContentsObserver(contents),
+      bytes_freed_(0) {}
 
 void RestoreHelper::ClearNeedsReload() {
   static_cast<WebContentsImpl*>(
@@ -35,7 +50,236 @@ DEFINE_WEB_CONTENTS_USER_DATA_KEY(content::RestoreHelper);
 
 namespace memory {
 
-GuestTabManager::GuestTabManager() : TabManager() {}
+namespace {
+
+const int kDefaultPolicyCheckIntervalSeconds = 30;
+const int kDefaultMinInactiveMinutes = 10;
+const int kDefaultMaxDiscardsPerCheck = 5;
+const int kDefaultMaxConcurrentLoads = 3;
+
+int64_t GetPrivateBytes(base::ProcessHandle handle) {
+  if (handle == base::kNullProcessHandle)
+    return 0;
+
+#if defined(OS_MACOSX)
+  std::unique_ptr<base::ProcessMetrics> metrics(
+      base::ProcessMetrics::CreateProcessMetrics(
+          handle, content::BrowserChildProcessHost::GetPortProvider()));
+#else
+  std::unique_ptr<base::ProcessMetrics> metrics(
+      base::ProcessMetrics::CreateProcessMetrics(handle));
+#endif
+  size_t private_bytes = 0;
+  size_t shared_bytes = 0;
+  if (!metrics->GetMemoryBytes(&private_bytes, &shared_bytes))
+    return 0;
+  return static_cast<int64_t>(private_bytes);
+}
+
+// Renderer processes can be shared so only a proportional part of the
+// process memory is attributed to each tab.
+int64_t EstimateBytesFreed(WebContents* old_contents) {
+  content::RenderProcessHost* host = old_contents->GetRenderProcessHost();
+  if (!host)
+    return 0;
+
+  // |old_contents| has already been removed from the tab strip
+  int tab_count = 1;
+  for (TabContentsIterator it; !it.done(); it.Next()) {
+    if (it->GetRenderProcessHost() == host)
+      tab_count++;
+  }
+  return GetPrivateBytes(host->GetHandle()) / tab_count;
+}
+
+// Higher scores are better discard candidates. Tabs that have been idle
+// for a long time and use a lot of memory score highest, tabs that have
+// already been discarded and reloaded are more expensive to discard again.
+double ScoreTab(const TabStats& stats,
+                int64_t bytes,
+                base::TimeTicks now) {
+  double idle_minutes = (now - stats.last_active).InSecondsF() / 60;
+  double megabytes = bytes / (1024.0 * 1024.0);
+  return (idle_minutes + 1) * (megabytes + 1) / (stats.discard_count + 1);
+}
+
+}  // namespace
+
+GuestTabManager::DiscardPolicy::DiscardPolicy()
+    : memory_budget(0),
+      check_interval(
+          base::TimeDelta::FromSeconds(kDefaultPolicyCheckIntervalSeconds)),
+      min_inactive_time(
+          base::TimeDelta::FromMinutes(kDefaultMinInactiveMinutes)),
+      max_discards_per_check(kDefaultMaxDiscardsPerCheck),
+      protect_pinned(true),
+      protect_audible(true),
+      protect_form_input(true) {}
+
+GuestTabManager::GuestTabManager()
+    : TabManager(),
+      pending_old_contents_(nullptr),
+      pending_null_contents_(nullptr),
+      max_concurrent_loads_(kDefaultMaxConcurrentLoads) {}
+
+GuestTabManager::~GuestTabManager() {}
+
+void GuestTabManager::SetDiscardPolicy(const DiscardPolicy& policy) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+
+  policy_ = policy;
+  policy_timer_.Stop();
+  if (policy_.memory_budget > 0) {
+    policy_timer_.Start(FROM_HERE, policy_.check_interval,
+        base::Bind(base::IgnoreResult(&GuestTabManager::EnforceDiscardPolicy),
+                   base::Unretained(this)));
+  }
+}
+
+void GuestTabManager::AddObserver(Observer* observer) {
+  observers_.AddObserver(observer);
+}
+
+void GuestTabManager::RemoveObserver(Observer* observer) {
+  observers_.RemoveObserver(observer);
+}
+
+void GuestTabManager::QueueBackgroundLoad(WebContents* contents) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+
+  if (loading_contents_.count(contents) ||
+      std::find(load_queue_.begin(), load_queue_.end(), contents) !=
+          load_queue_.end())
+    return;
+
+  load_queue_.push_back(contents);
+  MaybeStartBackgroundLoads();
+}
+
+void GuestTabManager::CancelBackgroundLoad(WebContents* contents) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+
+  load_queue_.erase(
+      std::remove(load_queue_.begin(), load_queue_.end(), contents),
+      load_queue_.end());
+  if (loading_contents_.erase(contents))
+    MaybeStartBackgroundLoads();
+}
+
+void GuestTabManager::OnBackgroundLoadFinished(WebContents* contents) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+
+  if (loading_contents_.erase(contents))
+    MaybeStartBackgroundLoads();
+}
+
+void GuestTabManager::MaybeStartBackgroundLoads() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+
+  auto it = load_queue_.begin();
+  while (it != load_queue_.end() &&
+         static_cast<int>(loading_contents_.size()) < max_concurrent_loads_) {
+    WebContents* contents = *it;
+    auto tab_helper = extensions::TabHelper::FromWebContents(contents);
+    if (!tab_helper || !tab_helper->IsDiscarded()) {
+      // already loaded, probably because it was activated
+      it = load_queue_.erase(it);
+      continue;
+    }
+
+    if (!tab_helper->guest()->attached()) {
+      // navigation before attachment isn't supported
+      ++it;
+      continue;
+    }
+
+    // Only a load that started frees its slot in DidStopLoading.
+    it = load_queue_.erase(it);
+    if (tab_helper->LoadIfDiscarded())
+      loading_contents_.insert(contents);
+  }
+}
+
+void GuestTabManager::set_max_concurrent_loads(int max_concurrent_loads) {
+  max_concurrent_loads_ = std::max(max_concurrent_loads, 1);
+  MaybeStartBackgroundLoads();
+}
+
+bool GuestTabManager::IsDiscardCandidate(const TabStats& stats,
+                                         base::TimeTicks now) const {
+  if (stats.is_selected ||
+      stats.is_discarded ||
+      stats.is_internal_page ||
+      !stats.is_auto_discardable)
+    return false;
+
+  if (now - stats.last_active < policy_.min_inactive_time)
+    return false;
+
+  if ((policy_.protect_pinned && stats.is_pinned) ||
+      (policy_.protect_audible && stats.is_media) ||
+      (policy_.protect_form_input && stats.has_form_entry))
+    return false;
+
+  return true;
+}
+
+int GuestTabManager::EnforceDiscardPolicy() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+
+  if (policy_.memory_budget <= 0)
+    return 0;
+
+  TabStatsList stats_list = GetUnsortedTabStats();
+
+  // private bytes and tab count for each renderer process
+  std::map<int, std::pair<int64_t, int>> process_memory;
+  for (const auto& stats : stats_list) {
+    if (stats.is_discarded)
+      continue;
+
+    auto& entry = process_memory[stats.child_process_host_id];
+    if (entry.second++ == 0)
+      entry.first = GetPrivateBytes(stats.renderer_handle);
+  }
+
+  int64_t total_bytes = 0;
+  for (const auto& entry : process_memory)
+    total_bytes += entry.second.first;
+
+  if (total_bytes <= policy_.memory_budget)
+    return 0;
+
+  base::TimeTicks now = NowTicks();
+  std::vector<DiscardCandidate> candidates;
+  for (const auto& stats : stats_list) {
+    if (!IsDiscardCandidate(stats, now))
+      continue;
+
+    const auto& entry = process_memory[stats.child_process_host_id];
+    int64_t bytes = entry.first / std::max(entry.second, 1);
+    candidates.push_back(
+        { stats.tab_contents_id, bytes, ScoreTab(stats, bytes, now) });
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const DiscardCandidate& a, const DiscardCandidate& b) {
+              return a.score > b.score;
+            });
+
+  int discarded = 0;
+  for (const auto& candidate : candidates) {
+    if (total_bytes <= policy_.memory_budget ||
+        discarded >= policy_.max_discards_per_check)
+      break;
+
+    if (DiscardTabById(candidate.tab_contents_id)) {
+      total_bytes -= candidate.bytes;
+      discarded++;
+    }
+  }
+  return discarded;
+}
 
 WebContents* GuestTabManager::CreateNullContents(
     TabStripModel* model, WebContents* old_contents) {
@@ -50,6 +294,9 @@ WebContents* GuestTabManager::CreateNullContents(
   params.initially_hidden = true;
   auto contents = extensions::TabHelper::CreateTab(embedder, params);
   content::RestoreHelper::CreateForWebContents(contents);
+
+  pending_old_contents_ = old_contents;
+  pending_null_contents_ = contents;
   return contents;
 }
 
@@ -58,6 +305,21 @@ void GuestTabManager::DestroyOldContents(WebContents* old_contents) {
 
   auto tab_helper = extensions::TabHelper::FromWebContents(old_contents);
   DCHECK(tab_helper && tab_helper->guest());
+  if (pending_old_contents_ == old_contents) {
+    // the renderer is still alive until the guest is destroyed
+    int64_t bytes_freed = EstimateBytesFreed(old_contents);
+    auto helper = content::RestoreHelper::FromWebContents(
+        pending_null_contents_);
+    if (helper)
+      helper->set_bytes_freed(bytes_freed);
+
+    for (Observer& observer : observers_)
+      observer.OnTabDiscarded(old_contents, pending_null_contents_,
+                              bytes_freed);
+  }
+  pending_old_contents_ = nullptr;
+  pending_null_contents_ = nullptr;
+
   // Let the guest destroy itself after the detach message has been received
   tab_helper->guest()->SetCanRunInDetachedState(false);
 }
@@ -84,6 +346,7 @@ void GuestTabManager::ActiveTabChanged(content::WebContents* old_contents,
   TabManager::ActiveTabChanged(old_contents, new_contents, index, reason);
   auto helper = content::RestoreHelper::FromWebContents(new_contents);
   if (helper) {
+    int64_t bytes_freed = helper->bytes_freed();
     helper->RemoveRestoreHelper();
 
     new_contents->WasHidden();
@@ -93,6 +356,9 @@ void GuestTabManager::ActiveTabChanged(content::WebContents* old_contents,
     if (!tab_helper->is_placeholder()) {
       // if the helper is set this is a discarded tab so we need to reload
       new_contents->GetController().Reload(content::ReloadType::NORMAL, true);
+
+      for (Observer& observer : observers_)
+        observer.OnTabRestored(new_contents, bytes_freed);
     }
   }
 }
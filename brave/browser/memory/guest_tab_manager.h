@@ -7,6 +7,12 @@
 
 #include "chrome/browser/memory/tab_manager.h"
 
+#include <deque>
+#include <set>
+
+#include "base/observer_list.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
@@ -22,6 +28,13 @@ class RestoreHelper : public WebContentsObserver,
   explicit RestoreHelper(WebContents* contents);
   void ClearNeedsReload();
   void RemoveRestoreHelper();
+
+  // Estimated number of bytes that were freed when the tab was discarded.
+  void set_bytes_freed(int64_t bytes_freed) { bytes_freed_ = bytes_freed; }
+  int64_t bytes_freed() const { return bytes_freed_; }
+
+ private:
+  int64_t bytes_freed_;
 };
 
 }  // namespace content
@@ -30,9 +43,71 @@ namespace memory {
 
 class GuestTabManager : public TabManager {
  public:
+  class Observer {
+   public:
+    // |old_contents| has been replaced by |new_contents| and is about to be
+    // destroyed.
+    virtual void OnTabDiscarded(content::WebContents* old_contents,
+                                content::WebContents* new_contents,
+                                int64_t bytes_freed) {}
+    virtual void OnTabRestored(content::WebContents* contents,
+                               int64_t bytes_freed) {}
+
+   protected:
+    virtual ~Observer() {}
+  };
+
+  // Controls proactive discarding of background tabs. A |memory_budget| of
+  // zero disables the policy and leaves discarding to the TabManager
+  // defaults.
+  struct DiscardPolicy {
+    DiscardPolicy();
+
+    // Maximum private memory in bytes for all tab renderers.
+    int64_t memory_budget;
+    base::TimeDelta check_interval;
+    // Tabs that were active more recently than this are never discarded.
+    base::TimeDelta min_inactive_time;
+    int max_discards_per_check;
+    bool protect_pinned;
+    bool protect_audible;
+    bool protect_form_input;
+  };
+
   GuestTabManager();
+  ~GuestTabManager() override;
+
+  void SetDiscardPolicy(const DiscardPolicy& policy);
+  const DiscardPolicy& discard_policy() const { return policy_; }
+
+  // Discards background tabs, highest score first, until the tab renderers
+  // fit in the memory budget. Returns the number of tabs discarded.
+  int EnforceDiscardPolicy();
+
+  void AddObserver(Observer* observer);
+  void RemoveObserver(Observer* observer);
+
+  // Queues a lazily restored tab to be loaded in the background. At most
+  // |max_concurrent_loads| queued tabs load at the same time and tabs that
+  // are not attached yet wait until they are.
+  void QueueBackgroundLoad(content::WebContents* contents);
+  void CancelBackgroundLoad(content::WebContents* contents);
+  void OnBackgroundLoadFinished(content::WebContents* contents);
+  void MaybeStartBackgroundLoads();
+
+  void set_max_concurrent_loads(int max_concurrent_loads);
+  int max_concurrent_loads() const { return max_concurrent_loads_; }
 
  private:
+  struct DiscardCandidate {
+    int64_t tab_contents_id;
+    int64_t bytes;
+    double score;
+  };
+
+  bool IsDiscardCandidate(const TabStats& stats,
+                          base::TimeTicks now) const;
+
   void ActiveTabChanged(content::WebContents* old_contents,
                         content::WebContents* new_contents,
                         int index,
@@ -46,6 +121,20 @@ class GuestTabManager : public TabManager {
       TabStripModel* model, content::WebContents* old_contents) override;
   void DestroyOldContents(content::WebContents* old_contents) override;
 
+  DiscardPolicy policy_;
+  base::RepeatingTimer policy_timer_;
+
+  // The null contents created for the most recent discard. Discards are
+  // synchronous so there is only ever one in flight.
+  content::WebContents* pending_old_contents_;
+  content::WebContents* pending_null_contents_;
+
+  base::ObserverList<Observer> observers_;
+
+  std::deque<content::WebContents*> load_queue_;
+  std::set<content::WebContents*> loading_contents_;
+  int max_concurrent_loads_;
+
   DISALLOW_COPY_AND_ASSIGN(GuestTabManager);
 };
 
@@ -235,6 +235,22 @@ bool ExtensionTabUtil::GetTabStripModel(const WebContents* web_contents,
   DCHECK(tab_strip_model);
   DCHECK(tab_index);
 
+  auto tab_helper = TabHelper::FromWebContents(web_contents);
+  if (tab_helper) {
+    Browser* browser = tab_helper->browser();
+    if (!browser)
+      return false;
+
+    int index = browser->tab_strip_model()->GetIndexOfWebContents(
+        web_contents);
+    if (index == TabStripModel::kNoTab)
+      return false;
+
+    *tab_strip_model = browser->tab_strip_model();
+    *tab_index = index;
+    return true;
+  }
+
   for (auto* browser : *BrowserList::GetInstance()) {
     TabStripModel* tab_strip = browser->tab_strip_model();
     int index = tab_strip->GetIndexOfWebContents(web_contents);
@@ -277,27 +293,32 @@ bool ExtensionTabUtil::GetTabById(int tab_id,
   Profile* incognito_profile =
       include_incognito && profile->HasOffTheRecordProfile() ?
           profile->GetOffTheRecordProfile() : NULL;
-  for (auto* target_browser : *BrowserList::GetInstance()) {
-    if (target_browser->profile() == profile ||
-        target_browser->profile() == incognito_profile) {
-      TabStripModel* target_tab_strip = target_browser->tab_strip_model();
-      for (int i = 0; i < target_tab_strip->count(); ++i) {
-        WebContents* target_contents = target_tab_strip->GetWebContentsAt(i);
-        if (SessionTabHelper::IdForTab(target_contents) == tab_id) {
-          if (browser)
-            *browser = target_browser;
-          if (tab_strip)
-            *tab_strip = target_tab_strip;
-          if (contents)
-            *contents = target_contents;
-          if (tab_index)
-            *tab_index = i;
-          return true;
-        }
-      }
-    }
-  }
-  return false;
+
+  auto tab_helper = TabHelper::FromTabId(tab_id);
+  if (!tab_helper)
+    return false;
+
+  Browser* target_browser = tab_helper->browser();
+  if (!target_browser ||
+      (target_browser->profile() != profile &&
+       target_browser->profile() != incognito_profile))
+    return false;
+
+  WebContents* target_contents = tab_helper->web_contents();
+  TabStripModel* target_tab_strip = target_browser->tab_strip_model();
+  int index = target_tab_strip->GetIndexOfWebContents(target_contents);
+  if (index == TabStripModel::kNoTab)
+    return false;
+
+  if (browser)
+    *browser = target_browser;
+  if (tab_strip)
+    *tab_strip = target_tab_strip;
+  if (contents)
+    *contents = target_contents;
+  if (tab_index)
+    *tab_index = index;
+  return true;
 }
 
 GURL ExtensionTabUtil::ResolvePossiblyRelativeURL(const std::string& url_string,
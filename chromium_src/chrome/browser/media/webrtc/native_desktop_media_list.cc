@@ -4,6 +4,7 @@
 
 #include "chrome/browser/media/webrtc/native_desktop_media_list.h"
 
+#include <algorithm>
 #include <map>
 #include <set>
 #include <sstream>
@@ -32,10 +33,25 @@ namespace {
 const int kDefaultUpdatePeriod = 1000;
 
 // Returns a hash of a DesktopFrame content to detect when image for a desktop
-// media source has changed.
-uint32_t GetFrameHash(webrtc::DesktopFrame* frame) {
-  int data_size = frame->stride() * frame->size().height();
-  return base::SuperFastHash(reinterpret_cast<char*>(frame->data()), data_size);
+// media source has changed. Hashing a full resolution frame costs about as
+// much as scaling it, so only about two rows per thumbnail row are hashed,
+// which is what the bilinear scaler reads. A change confined to the skipped
+// rows shows up with the next change to a hashed row. The stride padding is
+// left out, its content is undefined and would report changes that are not
+// there.
+uint32_t GetFrameHash(webrtc::DesktopFrame* frame, int thumbnail_height) {
+  const int width = frame->size().width();
+  const int height = frame->size().height();
+  const int row_size = width * webrtc::DesktopFrame::kBytesPerPixel;
+  const int row_step = std::max(height / std::max(thumbnail_height * 2, 1), 1);
+
+  uint32_t hash = static_cast<uint32_t>(width) * 31 + height;
+  for (int y = 0; y < height; y += row_step) {
+    const char* row =
+        reinterpret_cast<const char*>(frame->data() + y * frame->stride());
+    hash = hash * 31 + base::SuperFastHash(row, row_size);
+  }
+  return hash;
 }
 
 gfx::ImageSkia ScaleDesktopFrame(std::unique_ptr<webrtc::DesktopFrame> frame,
@@ -83,7 +99,8 @@ class NativeDesktopMediaList::Worker
  public:
   Worker(base::WeakPtr<NativeDesktopMediaList> media_list,
          std::unique_ptr<webrtc::DesktopCapturer> screen_capturer,
-         std::unique_ptr<webrtc::DesktopCapturer> window_capturer);
+         std::unique_ptr<webrtc::DesktopCapturer> window_capturer,
+         const std::set<DesktopMediaID>& source_filter);
   ~Worker() override;
 
   void Refresh(const gfx::Size& thumbnail_size,
@@ -103,6 +120,9 @@ class NativeDesktopMediaList::Worker
 
   std::unique_ptr<webrtc::DesktopFrame> current_frame_;
 
+  // Empty when every source is listed.
+  std::set<DesktopMediaID> source_filter_;
+
   ImageHashesMap image_hashes_;
 
   DISALLOW_COPY_AND_ASSIGN(Worker);
@@ -111,10 +131,12 @@ class NativeDesktopMediaList::Worker
 NativeDesktopMediaList::Worker::Worker(
     base::WeakPtr<NativeDesktopMediaList> media_list,
     std::unique_ptr<webrtc::DesktopCapturer> screen_capturer,
-    std::unique_ptr<webrtc::DesktopCapturer> window_capturer)
+    std::unique_ptr<webrtc::DesktopCapturer> window_capturer,
+    const std::set<DesktopMediaID>& source_filter)
     : media_list_(media_list),
       screen_capturer_(std::move(screen_capturer)),
-      window_capturer_(std::move(window_capturer)) {
+      window_capturer_(std::move(window_capturer)),
+      source_filter_(source_filter) {
   if (screen_capturer_)
     screen_capturer_->Start(this);
   if (window_capturer_)
@@ -139,8 +161,10 @@ void NativeDesktopMediaList::Worker::Refresh(
         } else {
           title = base::UTF8ToUTF16("Entire screen");
         }
-        sources.push_back(SourceDescription(DesktopMediaID(
-            DesktopMediaID::TYPE_SCREEN, screens[i].id), title));
+        DesktopMediaID id(DesktopMediaID::TYPE_SCREEN, screens[i].id);
+        if (!source_filter_.empty() && !source_filter_.count(id))
+          continue;
+        sources.push_back(SourceDescription(id, title));
       }
     }
   }
@@ -151,11 +175,12 @@ void NativeDesktopMediaList::Worker::Refresh(
       for (webrtc::DesktopCapturer::SourceList::iterator it = windows.begin();
            it != windows.end(); ++it) {
         // Skip the picker dialog window.
-        if (it->id != view_dialog_id) {
-          sources.push_back(SourceDescription(
-              DesktopMediaID(DesktopMediaID::TYPE_WINDOW, it->id),
-              base::UTF8ToUTF16(it->title)));
-        }
+        if (it->id == view_dialog_id)
+          continue;
+        DesktopMediaID id(DesktopMediaID::TYPE_WINDOW, it->id);
+        if (!source_filter_.empty() && !source_filter_.count(id))
+          continue;
+        sources.push_back(SourceDescription(id, base::UTF8ToUTF16(it->title)));
       }
     }
   }
@@ -167,8 +192,9 @@ void NativeDesktopMediaList::Worker::Refresh(
 
   ImageHashesMap new_image_hashes;
 
-  // Get a thumbnail for each source.
-  for (size_t i = 0; i < sources.size(); ++i) {
+  // Get a thumbnail for each source, capturing is by far the most expensive
+  // part of a refresh so it is skipped when no thumbnail is wanted.
+  for (size_t i = 0; !thumbnail_size.IsEmpty() && i < sources.size(); ++i) {
     SourceDescription& source = sources[i];
     switch (source.id.type) {
       case DesktopMediaID::TYPE_SCREEN:
@@ -191,7 +217,8 @@ void NativeDesktopMediaList::Worker::Refresh(
     // |current_frame_| may be NULL if capture failed (e.g. because window has
     // been closed).
     if (current_frame_) {
-      uint32_t frame_hash = GetFrameHash(current_frame_.get());
+      uint32_t frame_hash =
+          GetFrameHash(current_frame_.get(), thumbnail_size.height());
       new_image_hashes[source.id] = frame_hash;
 
       // Scale the image only if it has changed.
@@ -249,6 +276,12 @@ void NativeDesktopMediaList::SetThumbnailSize(
   thumbnail_size_ = thumbnail_size;
 }
 
+void NativeDesktopMediaList::SetSourceFilter(
+    const std::set<content::DesktopMediaID>& source_ids) {
+  DCHECK(!observer_);
+  source_filter_ = source_ids;
+}
+
 void NativeDesktopMediaList::SetViewDialogWindowId(
     content::DesktopMediaID::Id dialog_id) {
   view_dialog_id_ = dialog_id;
@@ -262,7 +295,8 @@ void NativeDesktopMediaList::StartUpdating(DesktopMediaListObserver* observer) {
 
   worker_.reset(new Worker(weak_factory_.GetWeakPtr(),
                            std::move(screen_capturer_),
-                           std::move(window_capturer_)));
+                           std::move(window_capturer_),
+                           source_filter_));
   Refresh();
 }
 
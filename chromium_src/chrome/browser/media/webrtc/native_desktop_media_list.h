@@ -5,6 +5,8 @@
 #ifndef CHROME_BROWSER_MEDIA_NATIVE_DESKTOP_MEDIA_LIST_H_
 #define CHROME_BROWSER_MEDIA_NATIVE_DESKTOP_MEDIA_LIST_H_
 
+#include <set>
+
 #include "base/memory/weak_ptr.h"
 #include "base/sequenced_task_runner.h"
 #include "chrome/browser/media/webrtc/desktop_media_list.h"
@@ -36,6 +38,10 @@ class NativeDesktopMediaList : public DesktopMediaList {
   std::vector<Source> GetSources() const override;
   void SetViewDialogWindowId(content::DesktopMediaID::Id dialog_id) override;
 
+  // Limits the list to |source_ids|, an empty set lists every source. Must be
+  // called before StartUpdating().
+  void SetSourceFilter(const std::set<content::DesktopMediaID>& source_ids);
+
  private:
   class Worker;
   friend class Worker;
@@ -70,7 +76,11 @@ class NativeDesktopMediaList : public DesktopMediaList {
   // Time interval between mode updates.
   base::TimeDelta update_period_;
 
-  // Size of thumbnails generated by the model.
+  // Sources the list is limited to, passed to the |worker_| later.
+  std::set<content::DesktopMediaID> source_filter_;
+
+  // Size of thumbnails generated by the model, no thumbnail is captured when
+  // it is empty.
   gfx::Size thumbnail_size_;
 
   // ID of the hosting dialog.
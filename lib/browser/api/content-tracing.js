@@ -1 +1,32 @@
-module.exports = process.atomBinding('content_tracing')
+const binding = process.atomBinding('content_tracing')
+
+// Category filters of the trace events around Electron's own hot paths, the
+// Chromium categories that go with them are included.
+const presets = {
+  asar: 'electron.asar',
+  ipc: 'electron.ipc,ipc',
+  net: 'electron.net,net',
+  startup: 'electron.startup,startup',
+  electron: 'electron.asar,electron.ipc,electron.net,electron.startup'
+}
+
+const {startRecording} = binding
+
+binding.presets = Object.keys(presets)
+
+binding.startRecording = function (options, callback) {
+  if (options != null && options.preset != null) {
+    const categoryFilter = presets[options.preset]
+    if (categoryFilter == null) {
+      throw new Error(`Unknown tracing preset: ${options.preset}`)
+    }
+    options = Object.assign({traceOptions: 'record-until-full'}, options, {
+      categoryFilter: options.categoryFilter
+        ? `${categoryFilter},${options.categoryFilter}`
+        : categoryFilter
+    })
+  }
+  return startRecording(options, callback)
+}
+
+module.exports = binding
@@ -5,6 +5,7 @@ const path = require('path')
 const spawn = require('child_process').spawn
 const {app} = require('electron')
 const binding = process.atomBinding('crash_reporter')
+const uploader = process.atomBinding('crash_report_uploader')
 
 var CrashReporter = (function () {
   function CrashReporter () {}
@@ -20,6 +21,7 @@ var CrashReporter = (function () {
     autoSubmit = options.autoSubmit
     ignoreSystemCrashHandler = options.ignoreSystemCrashHandler
     extra = options.extra
+    this.submitURL = submitURL
 
     if (this.productName == null) {
       this.productName = app.getName()
@@ -49,6 +51,7 @@ var CrashReporter = (function () {
       throw new Error('submitURL is a required option to crashReporter.start')
     }
     start = () => {
+      binding._setUploadToSpool(Boolean(options.spool))
       binding.start(this.productName, companyName, submitURL, autoSubmit, ignoreSystemCrashHandler, extra)
     }
     if (process.platform === 'win32') {
@@ -74,6 +77,21 @@ var CrashReporter = (function () {
     }
   }
 
+  CrashReporter.prototype.uploadSpooledReports = function (options, callback) {
+    if (typeof options === 'function') {
+      callback = options
+      options = {}
+    }
+    options = Object.assign({
+      directory: path.join('/tmp', (this.productName || app.getName()) + ' Crashes'),
+      submitURL: this.submitURL
+    }, options)
+    if (options.submitURL == null) {
+      throw new Error('submitURL is a required option to crashReporter.uploadSpooledReports')
+    }
+    uploader.upload(options, callback || function () {})
+  }
+
   CrashReporter.prototype.getUploadedReports = function () {
     var log, tmpdir
     tmpdir = process.platform === 'win32' ? os.tmpdir() : '/tmp'
@@ -0,0 +1,54 @@
+const {desktopCapturer} = process.atomBinding('desktop_capturer')
+
+// Requests waiting for the capturer, it handles one at a time.
+const requestsQueue = []
+let currentRequest = null
+
+const startNextRequest = function () {
+  currentRequest = requestsQueue.shift() || null
+  if (currentRequest == null) return
+
+  const {types, thumbnailSize, sourceIds, refreshInterval} = currentRequest
+  desktopCapturer.startHandling(types.includes('window'),
+                                types.includes('screen'),
+                                thumbnailSize, {sourceIds, refreshInterval})
+}
+
+desktopCapturer.emit = function (name, event, sources) {
+  if (name !== 'finished' || currentRequest == null) return
+
+  // A refreshing request keeps the capturer until another request comes in.
+  const request = currentRequest
+  if (!request.refreshInterval || requestsQueue.length > 0) {
+    if (request.refreshInterval) desktopCapturer.stopHandling()
+    startNextRequest()
+  }
+  request.callback(null, sources)
+}
+
+exports.getSources = function (options, callback) {
+  if (options == null || !Array.isArray(options.types)) {
+    return callback(new Error('Invalid options'))
+  }
+
+  requestsQueue.push({
+    types: options.types,
+    thumbnailSize: options.thumbnailSize || {width: 150, height: 150},
+    sourceIds: options.sourceIds || [],
+    refreshInterval: options.refreshInterval || 0,
+    callback
+  })
+
+  if (currentRequest == null) {
+    startNextRequest()
+  } else if (currentRequest.refreshInterval) {
+    desktopCapturer.stopHandling()
+    startNextRequest()
+  }
+}
+
+exports.stopRefreshing = function () {
+  if (currentRequest == null || !currentRequest.refreshInterval) return
+  desktopCapturer.stopHandling()
+  startNextRequest()
+}
@@ -337,24 +337,20 @@ const tabsQuery = function (queryInfo = {}, useCurrentWindowId = false) {
   }
 
   var queryKeys = Object.keys(queryInfo)
-  // get the values for all tabs
-  var tabValues = tabIds.reduce((tabs, tabId) => {
-    tabs[tabId] = getTabValue(tabId) || {}
-    return tabs
-  }, {})
 
   var result = []
-  tabIds.forEach((tabId) => {
+  for (var i = 0; i < tabIds.length; i++) {
+    var tabValue = getTabValue(tabIds[i])
     // never add the master Brave container window
-    if (tabValues[tabId].url.startsWith('chrome://brave')) {
-      return
+    if (!tabValue || tabValue.url.startsWith('chrome://brave')) {
+      continue
     }
 
-    // delete tab from the list if any key doesn't match
-    if (!queryKeys.map((queryKey) => (tabValues[tabId][queryKey] === queryInfo[queryKey])).includes(false)) {
-      result.push(tabValues[tabId])
+    // skip the tab if any key doesn't match
+    if (queryKeys.every((queryKey) => tabValue[queryKey] === queryInfo[queryKey])) {
+      result.push(tabValue)
     }
-  })
+  }
 
   return result
 }
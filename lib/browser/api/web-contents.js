@@ -126,6 +126,20 @@ WebContents.prototype.attach = function(windowId, cb) {
   return attach
 }
 
+// Captures the page scaled to options.width/options.height and encodes it to
+// options.format off the UI thread.
+WebContents.prototype.capturePageWithOptions = function (options = {}) {
+  return new Promise((resolve, reject) => {
+    this._capturePageWithOptions(options, (data, size) => {
+      if (data == null) {
+        reject(new Error('Failed to capture page'))
+      } else {
+        resolve({data, size})
+      }
+    })
+  })
+}
+
 // Translate the options of printToPDF.
 WebContents.prototype.printToPDF = function (options, callback) {
   const printingSetting = Object.assign({}, defaultPrintingSetting)
@@ -249,5 +263,13 @@ module.exports = {
 
   getAllWebContents () {
     return binding.getAllWebContents()
+  },
+
+  registerScript (extensionId, code) {
+    return binding.registerScript(extensionId, code)
+  },
+
+  unregisterScript (handle) {
+    binding.unregisterScript(handle)
   }
 }
@@ -44,49 +44,46 @@ let supportedWebViewEvents = [
   'did-block-run-insecure-content'
 ]
 
-let guests = {}
-const registerGuest = function (guest, embedder) {
-  const tabId = guest.getId()
-
-  embedder.once('destroyed', function () {
-    if (guests[tabId] === embedder) {
-      guests[tabId] = false
-    }
-  })
+// The embedder each guest forwards its events to, null while it is detached.
+// Keyed by the guest itself so nothing is kept once the guest is collected.
+const embedders = new WeakMap()
 
-  const oldEmbedder = guests[tabId]
-  guests[tabId] = embedder
-  if (oldEmbedder !== undefined) {
-    return
-  }
+const forwardingEnds = ['destroyed', 'crashed', 'did-detach', 'will-detach']
 
-  // Dispatch events to embedder.
-  const fn = function (event) {
-    guest.on(event, function (_, ...args) {
-      const embedder = guests[tabId]
+const addForwarding = function (guest) {
+  // The id can not be read once the guest is destroyed, so it is cached and
+  // refreshed when the guest is attached again and before it is destroyed.
+  let tabId = guest.getId()
+  guest.on('will-attach', function () {
+    tabId = guest.getId()
+  })
+  guest.on('will-destroy', function () {
+    tabId = guest.getId()
+  })
 
-      if (!embedder || embedder.isDestroyed())
-        return
+  const forward = function (event, args) {
+    const embedder = embedders.get(guest)
+    if (!embedder || embedder.isDestroyed())
+      return
 
-      let forceSend = false
-      if (['destroyed', 'crashed', 'did-detach', 'will-detach'].includes(event)) {
-        delete guests[tabId]
-        forceSend = true
-      }
+    const forceSend = forwardingEnds.includes(event)
+    if (forceSend)
+      embedders.set(guest, null)
 
-      if (guest.isDestroyed() && !forceSend)
-        return
+    if (guest.isDestroyed() && !forceSend)
+      return
 
-      embedder.send.apply(embedder, ['ELECTRON_GUEST_VIEW_INTERNAL_DISPATCH_EVENT-' + tabId, event].concat(args))
-    })
+    embedder.send.apply(embedder, ['ELECTRON_GUEST_VIEW_INTERNAL_DISPATCH_EVENT-' + tabId, event].concat(args))
   }
   for (const event of supportedWebViewEvents) {
-    fn(event)
+    guest.on(event, function (_, ...args) {
+      forward(event, args)
+    })
   }
 
   // Dispatch guest's IPC messages to embedder.
   guest.on('ipc-message-host', function (_, [channel, ...args]) {
-    const embedder = guests[tabId]
+    const embedder = embedders.get(guest)
     if (!embedder || embedder.isDestroyed() || guest.isDestroyed())
       return
 
@@ -94,4 +91,12 @@ const registerGuest = function (guest, embedder) {
   })
 }
 
+// Called each time |guest| is about to be attached to |embedder|, the
+// listeners are only added the first time.
+const registerGuest = function (guest, embedder) {
+  if (!embedders.has(guest))
+    addForwarding(guest)
+  embedders.set(guest, embedder)
+}
+
 exports.registerGuest = registerGuest
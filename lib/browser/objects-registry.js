@@ -8,7 +8,7 @@ class ObjectsRegistry {
 
     // Stores all objects by ref-counting.
     // (id) => {object, count}
-    this.storage = {}
+    this.storage = new Map()
 
     // Stores the IDs of objects referenced by WebContents.
     // (webContentsId) => [id]
@@ -34,14 +34,14 @@ class ObjectsRegistry {
     if (!owner.has(id)) {
       owner.add(id)
       // Increase reference count if not referenced before.
-      this.storage[id].count++
+      this.storage.get(id).count++
     }
     return id
   }
 
   // Get an object according to its ID.
   get (id) {
-    return this.storage[id].object
+    return this.storage.get(id).object
   }
 
   // Dereference an object according to its ID.
@@ -60,6 +60,11 @@ class ObjectsRegistry {
     }
   }
 
+  // Dereference a list of objects released by the WebContents together.
+  removeAll (webContentsId, ids) {
+    for (let id of ids) this.remove(webContentsId, id)
+  }
+
   // Clear all references to objects refrenced by the WebContents.
   clear (webContentsId) {
     let owner = this.owners[webContentsId]
@@ -75,10 +80,10 @@ class ObjectsRegistry {
     let id = v8Util.getHiddenValue(object, 'atomId')
     if (!id) {
       id = ++this.nextId
-      this.storage[id] = {
+      this.storage.set(id, {
         count: 0,
         object: object
-      }
+      })
       v8Util.setHiddenValue(object, 'atomId', id)
     }
     return id
@@ -86,14 +91,14 @@ class ObjectsRegistry {
 
   // Private: Dereference the object from store.
   dereference (id) {
-    let pointer = this.storage[id]
+    let pointer = this.storage.get(id)
     if (pointer == null) {
       return
     }
     pointer.count -= 1
     if (pointer.count === 0) {
       v8Util.deleteHiddenValue(pointer.object, 'atomId')
-      return delete this.storage[id]
+      return this.storage.delete(id)
     }
   }
 }
@@ -9,47 +9,45 @@ const objectsRegistry = require('./objects-registry')
 
 const hasProp = {}.hasOwnProperty
 
-// The internal properties of Function.
-const FUNCTION_PROPERTIES = [
-  'length', 'name', 'arguments', 'caller', 'prototype'
-]
-
 // The remote functions in renderer processes.
 // id => Function
 let rendererFunctions = v8Util.createDoubleIDWeakMap()
 
-// Return the description of object's members:
-let getObjectMembers = function (object) {
-  let names = Object.getOwnPropertyNames(object)
-  // For Function, we should not override following properties even though they
-  // are "own" properties.
-  if (typeof object === 'function') {
-    names = names.filter((name) => {
-      return !FUNCTION_PROPERTIES.includes(name)
-    })
-  }
-  // Map properties to descriptors.
-  return names.map((name) => {
-    let descriptor = Object.getOwnPropertyDescriptor(object, name)
-    let member = {name, enumerable: descriptor.enumerable, writable: false}
-    if (descriptor.get === undefined && typeof object[name] === 'function') {
-      member.type = 'method'
-    } else {
-      if (descriptor.set || descriptor.writable) member.writable = true
-      member.type = 'get'
-    }
-    return member
-  })
-}
+// The descriptions of prototypes, generated once per prototype object so
+// that repeated calls only send the prototype's id.
+// prototype => {id, count, members, proto}
+let prototypeDescriptors = new WeakMap()
+// id => prototype
+let prototypesById = v8Util.createIDWeakMap()
+let nextPrototypeId = 0
 
-// Return the description of object's prototype.
+// Return the id of object's prototype description.
 let getObjectPrototype = function (object) {
   let proto = Object.getPrototypeOf(object)
   if (proto === null || proto === Object.prototype) return null
-  return {
-    members: getObjectMembers(proto),
-    proto: getObjectPrototype(proto)
+
+  // Regenerate the description when members were added or removed. Checking
+  // every member on each call would cost as much as not caching, so a member
+  // replaced by one of another type keeps its old description.
+  let parentId = getObjectPrototype(proto)
+  let count = Object.getOwnPropertyNames(proto).length
+  let cached = prototypeDescriptors.get(proto)
+  if (cached && cached.count === count && cached.proto === parentId) {
+    return cached.id
   }
+
+  // The superseded id is never handed out again.
+  if (cached) prototypesById.remove(cached.id)
+
+  let id = ++nextPrototypeId
+  prototypeDescriptors.set(proto, {
+    id,
+    count,
+    members: v8Util.getObjectMembers(proto),
+    proto: parentId
+  })
+  prototypesById.set(id, proto)
+  return id
 }
 
 // Convert a real value into meta data.
@@ -89,7 +87,7 @@ let valueToMeta = function (sender, value, optimizeSimpleObject = false) {
     // passed to renderer we would assume the renderer keeps a reference of
     // it.
     meta.id = objectsRegistry.add(sender, value)
-    meta.members = getObjectMembers(value)
+    meta.members = v8Util.getObjectMembers(value)
     meta.proto = getObjectPrototype(value)
   } else if (meta.type === 'buffer') {
     meta.value = Buffer.from(value)
@@ -346,8 +344,18 @@ ipcMain.on('ELECTRON_BROWSER_MEMBER_GET', function (event, id, name) {
   }
 })
 
-ipcMain.on('ELECTRON_BROWSER_DEREFERENCE', function (event, id) {
-  objectsRegistry.remove(event.sender.getId(), id)
+ipcMain.on('ELECTRON_BROWSER_GET_PROTOTYPE', function (event, id) {
+  let proto = prototypesById.get(id)
+  let descriptor = proto && prototypeDescriptors.get(proto)
+  if (descriptor && descriptor.id === id) {
+    event.returnValue = {members: descriptor.members, proto: descriptor.proto}
+  } else {
+    event.returnValue = null
+  }
+})
+
+ipcMain.on('ELECTRON_BROWSER_DEREFERENCE', function (event, ids) {
+  objectsRegistry.removeAll(event.sender.getId(), ids)
 })
 
 ipcMain.on('ELECTRON_BROWSER_SEND_TO', function (event, sendToAll, webContentsId, channel, ...args) {
@@ -10,6 +10,12 @@ const callbacksRegistry = new CallbacksRegistry()
 
 const remoteObjectCache = v8Util.createIDWeakMap()
 
+// The prototype descriptions received from browser, kept in least recently
+// used order so ids superseded in the browser eventually drop out.
+// id => {members, proto}
+const prototypeDescriptors = new Map()
+const maxPrototypeDescriptors = 1000
+
 // Convert the arguments object into an array of meta data.
 const wrapArgs = function (args, visited) {
   if (visited == null) {
@@ -95,7 +101,7 @@ const wrapArgs = function (args, visited) {
 
 // Populate object's members from descriptors.
 // The |ref| will be kept referenced by |members|.
-// This matches |getObjectMemebers| in rpc-server.
+// This matches |getObjectMembers| in v8_util.
 const setObjectMembers = function (ref, object, metaId, members) {
   for (let member of members) {
     if (object.hasOwnProperty(member.name)) continue
@@ -144,9 +150,28 @@ const setObjectMembers = function (ref, object, metaId, members) {
   }
 }
 
+// Return the prototype description with |id|, fetching it from browser
+// when it's used for the first time.
+const getPrototypeDescriptor = function (id) {
+  if (id === null) return null
+  let descriptor = prototypeDescriptors.get(id)
+  if (descriptor === undefined) {
+    descriptor = ipcRenderer.sendSync('ELECTRON_BROWSER_GET_PROTOTYPE', id)
+    if (descriptor === null) return null
+    if (prototypeDescriptors.size >= maxPrototypeDescriptors) {
+      prototypeDescriptors.delete(prototypeDescriptors.keys().next().value)
+    }
+  } else {
+    prototypeDescriptors.delete(id)
+  }
+  prototypeDescriptors.set(id, descriptor)
+  return descriptor
+}
+
 // Populate object's prototype from descriptor.
 // This matches |getObjectPrototype| in rpc-server.
-const setObjectPrototype = function (ref, object, metaId, descriptor) {
+const setObjectPrototype = function (ref, object, metaId, protoId) {
+  let descriptor = getPrototypeDescriptor(protoId)
   if (descriptor === null) return
   let proto = {}
   setObjectMembers(ref, proto, metaId, descriptor.members)
@@ -285,8 +310,8 @@ ipcRenderer.on('ELECTRON_RENDERER_CALLBACK', function (event, id, args) {
 })
 
 // // A callback in browser is released.
-ipcRenderer.on('ELECTRON_RENDERER_RELEASE_CALLBACK', function (event, id) {
-  callbacksRegistry.remove(id)
+ipcRenderer.on('ELECTRON_RENDERER_RELEASE_CALLBACK', function (event, ids) {
+  for (let id of ids) callbacksRegistry.remove(id)
 })
 
 var binding = {}
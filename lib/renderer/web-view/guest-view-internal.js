@@ -55,18 +55,27 @@ var dispatchEvent = function (webView, eventName, eventKey, ...args) {
 }
 
 const GuestViewInternal = {
+  // Returns a function that removes only the listeners added for |webView|.
   registerEvents: function (webView, tabId) {
-    ipcRenderer.on('ELECTRON_GUEST_VIEW_INTERNAL_DISPATCH_EVENT-' + tabId, function (event, eventName, ...args) {
-      dispatchEvent.apply(null, [webView, eventName, eventName].concat(args))
-    })
+    const eventChannel = 'ELECTRON_GUEST_VIEW_INTERNAL_DISPATCH_EVENT-' + tabId
+    const messageChannel = 'ELECTRON_GUEST_VIEW_INTERNAL_IPC_MESSAGE-' + tabId
 
-    ipcRenderer.on('ELECTRON_GUEST_VIEW_INTERNAL_IPC_MESSAGE-' + tabId, function (event, channel, ...args) {
+    const onEvent = function (event, eventName, ...args) {
+      dispatchEvent.apply(null, [webView, eventName, eventName].concat(args))
+    }
+    const onMessage = function (event, channel, ...args) {
       var domEvent = new Event('ipc-message')
       domEvent.channel = channel
       domEvent.args = args
       webView.dispatchEvent(domEvent)
-    })
+    }
+    ipcRenderer.on(eventChannel, onEvent)
+    ipcRenderer.on(messageChannel, onMessage)
 
+    return function () {
+      ipcRenderer.removeListener(eventChannel, onEvent)
+      ipcRenderer.removeListener(messageChannel, onMessage)
+    }
   },
   deregisterEvents: function (tabId) {
     ipcRenderer.removeAllListeners('ELECTRON_GUEST_VIEW_INTERNAL_DISPATCH_EVENT-' + tabId)
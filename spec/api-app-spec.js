@@ -329,6 +329,35 @@ describe('app module', function () {
     })
   })
 
+  describe('getProcessMetrics() API', function () {
+    it('describes the browser and renderer processes', function (done) {
+      const webContentsId = remote.getCurrentWebContents().getId()
+      app.getProcessMetrics(function (processes) {
+        assert.ok(processes.length >= 2)
+        processes.forEach(function (metrics) {
+          assert.equal(typeof metrics.pid, 'number')
+          assert.equal(typeof metrics.type, 'string')
+          assert.equal(typeof metrics.workingSetSize, 'number')
+          assert.equal(typeof metrics.cpu, 'number')
+        })
+
+        const browser = processes.find((metrics) => metrics.type === 'browser')
+        assert.equal(browser.pid, remote.process.pid)
+        assert.ok(browser.isolates.length >= 1)
+        browser.isolates.forEach(function (isolate) {
+          assert.equal(typeof isolate.threadId, 'number')
+          assert.ok(isolate.usedHeapSize > 0)
+          assert.ok(isolate.usedHeapSize <= isolate.totalHeapSize)
+        })
+
+        const renderer = processes.find((metrics) => metrics.pid === process.pid)
+        assert.equal(renderer.type, 'renderer')
+        assert.notEqual(renderer.webContents.indexOf(webContentsId), -1)
+        done()
+      })
+    })
+  })
+
   describe('isAccessibilitySupportEnabled API', function () {
     it('returns whether the Chrome has accessibility APIs enabled', function () {
       assert.equal(typeof app.isAccessibilitySupportEnabled(), 'boolean')
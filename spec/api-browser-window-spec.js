@@ -269,6 +269,63 @@ describe('browser-window module', function () {
     })
   })
 
+  describe('webContents.capturePageWithOptions(options)', function () {
+    it('rejects unsupported formats', function (done) {
+      w.webContents.capturePageWithOptions({format: 'tiff'}).then(function () {
+        done(new Error('capture should have failed'))
+      }, function (error) {
+        assert.ok(error)
+        done()
+      })
+    })
+
+    describe('on a shown window', function () {
+      beforeEach(function (done) {
+        closeWindow(w).then(function () {
+          w = new BrowserWindow({
+            show: true,
+            width: 400,
+            height: 400
+          })
+          w.webContents.once('did-finish-load', function () { done() })
+          w.loadURL('file://' + path.join(fixtures, 'pages', 'content.html'))
+        })
+      })
+
+      it('scales the page to the given width and keeps the aspect ratio', function () {
+        return w.webContents.capturePageWithOptions({width: 100}).then(function ({data, size}) {
+          let [width, height] = w.getContentSize()
+          assert.equal(size.width, 100)
+          assert.ok(Math.abs(size.height - 100 * height / width) <= 1)
+          assert.equal(data.isEmpty(), false)
+          assert.deepEqual(data.getSize(), size)
+        })
+      })
+
+      it('encodes PNG', function () {
+        return w.webContents.capturePageWithOptions({width: 50, format: 'png'}).then(function ({data}) {
+          assert.ok(Buffer.isBuffer(data))
+          assert.deepEqual([...data.slice(0, 4)], [0x89, 0x50, 0x4e, 0x47])
+        })
+      })
+
+      it('encodes JPEG', function () {
+        return w.webContents.capturePageWithOptions({width: 50, format: 'jpeg', quality: 50}).then(function ({data}) {
+          assert.ok(Buffer.isBuffer(data))
+          assert.deepEqual([...data.slice(0, 2)], [0xff, 0xd8])
+        })
+      })
+
+      it('only captures the rect', function () {
+        const rect = {x: 10, y: 10, width: 100, height: 50}
+        return w.webContents.capturePageWithOptions({rect, width: 40}).then(function ({data, size}) {
+          assert.deepEqual(size, {width: 40, height: 20})
+          assert.deepEqual(data.getSize(), size)
+        })
+      })
+    })
+  })
+
   describe('BrowserWindow.setSize(width, height)', function () {
     it('sets the window size', function (done) {
       var size = [300, 400]
@@ -554,6 +611,29 @@ describe('browser-window module', function () {
       })
     })
 
+    describe('after a cross-site navigation', function () {
+      it('applies the preferences to the new render process', function (done) {
+        var preload = path.join(fixtures, 'module', 'send-later.js')
+        ipcMain.once('answer', function (event, test) {
+          assert.equal(test, 'undefined')
+          ipcMain.once('answer', function (event, test) {
+            assert.equal(test, 'undefined')
+            done()
+          })
+          w.loadURL(server.url + '/cross-site')
+        })
+        w.destroy()
+        w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            preload: preload,
+            nodeIntegration: false
+          }
+        })
+        w.loadURL('file://' + path.join(fixtures, 'api', 'blank.html'))
+      })
+    })
+
     describe('"node-integration" option', function () {
       it('disables node integration when specified to false', function (done) {
         var preload = path.join(fixtures, 'module', 'send-later.js')
@@ -1,6 +1,8 @@
 const assert = require('assert')
+const fs = require('fs')
 const http = require('http')
 const multiparty = require('multiparty')
+const os = require('os')
 const path = require('path')
 const url = require('url')
 const {closeWindow} = require('./window-helpers')
@@ -109,4 +111,32 @@ describe('crashReporter module', function () {
       })
     })
   })
+
+  describe('.uploadSpooledReports(options, callback)', function () {
+    it('uploads spooled reports to a file sink', function (done) {
+      const spool = fs.mkdtempSync(path.join(os.tmpdir(), 'crash-spool-'))
+      const sink = path.join(spool, 'sink')
+      const report = path.join(spool, 'spooled.dmp')
+      fs.writeFileSync(report, '--boundary\r\n' +
+        'Content-Disposition: form-data; name="prod"\r\n\r\n' +
+        'Electron\r\n' +
+        '--boundary--\r\n')
+      // Recent reports may still be written by a crashing process.
+      const past = Date.now() / 1000 - 60
+      fs.utimesSync(report, past, past)
+
+      crashReporter.uploadSpooledReports({
+        directory: spool,
+        submitURL: url.format({protocol: 'file', pathname: sink}),
+        compress: true
+      }, function (result) {
+        assert.equal(result.uploaded, 1)
+        assert.equal(result.failed, 0)
+        assert.ok(fs.existsSync(path.join(sink, 'spooled.dmp.gz')))
+        assert.ok(!fs.existsSync(report))
+        assert.ok(!fs.existsSync(report + '.gz'))
+        done()
+      })
+    })
+  })
 })
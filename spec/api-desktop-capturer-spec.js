@@ -1,7 +1,8 @@
 const assert = require('assert')
-const desktopCapturer = require('electron').desktopCapturer
+const {remote} = require('electron')
 
-const isCI = require('electron').remote.getGlobal('isCi')
+const desktopCapturer = remote.getBuiltin('desktopCapturer')
+const isCI = remote.getGlobal('isCi')
 
 describe('desktopCapturer', function () {
   if (isCI && process.platform === 'win32') {
@@ -49,4 +50,53 @@ describe('desktopCapturer', function () {
     desktopCapturer.getSources({types: ['window']}, callback)
     desktopCapturer.getSources({types: ['screen']}, callback)
   })
+
+  it('only lists the sources in sourceIds', function (done) {
+    desktopCapturer.getSources({types: ['screen']}, function (error, sources) {
+      assert.equal(error, null)
+      const id = sources[0].id
+      desktopCapturer.getSources({
+        types: ['window', 'screen'],
+        sourceIds: [id]
+      }, function (error, filtered) {
+        assert.equal(error, null)
+        assert.equal(filtered.length, 1)
+        assert.equal(filtered[0].id, id)
+        done()
+      })
+    })
+  })
+
+  it('skips the thumbnails for an empty thumbnailSize', function (done) {
+    desktopCapturer.getSources({
+      types: ['screen'],
+      thumbnailSize: {width: 0, height: 0}
+    }, function (error, sources) {
+      assert.equal(error, null)
+      assert.notEqual(sources.length, 0)
+      assert.equal(sources[0].thumbnail.isEmpty(), true)
+      done()
+    })
+  })
+
+  it('keeps refreshing with refreshInterval until stopped', function (done) {
+    var callCount = 0
+    desktopCapturer.getSources({
+      types: ['screen'],
+      refreshInterval: 100
+    }, function (error, sources) {
+      assert.equal(error, null)
+      if (++callCount === 3) {
+        desktopCapturer.stopRefreshing()
+        // Let the refreshes already on their way arrive first.
+        setTimeout(function () {
+          const stoppedAt = callCount
+          setTimeout(function () {
+            assert.equal(callCount, stoppedAt)
+            done()
+          }, 500)
+        }, 200)
+      }
+    })
+  })
 })
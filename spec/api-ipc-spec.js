@@ -324,6 +324,26 @@ describe('ipc module', function () {
     })
   })
 
+  describe('remote objects with many members', function () {
+    let manyMembers = remote.require(path.join(fixtures, 'module', 'many-members.js'))
+
+    it('shares the prototype description between objects', function () {
+      let a = manyMembers.create()
+      let b = manyMembers.create()
+      assert.equal(a.method499(), 499)
+      assert.equal(b.getCount(), 500)
+    })
+
+    it('reflects members added to the prototype on new objects', function () {
+      let a = manyMembers.create()
+      assert.equal(a.method500, undefined)
+      manyMembers.addMethod()
+      let b = manyMembers.create()
+      assert.equal(b.method500(), 500)
+      assert.equal(b.method1(), 1)
+    })
+  })
+
   describe('ipc.sender.send', function () {
     it('should work when sending an object containing id property', function (done) {
       var obj = {
@@ -59,4 +59,33 @@ describe('nativeImage module', () => {
       assert.equal(image.getSize().width, 256)
     })
   })
+
+  describe('createFromBufferAsync(buffer, callback)', () => {
+    it('decodes PNG data', (done) => {
+      const imagePath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+      const buffer = nativeImage.createFromPath(imagePath).toPNG()
+      nativeImage.createFromBufferAsync(buffer, (image) => {
+        assert(!image.isEmpty())
+        assert.equal(image.getSize().height, 190)
+        assert.equal(image.getSize().width, 538)
+        done()
+      })
+    })
+
+    it('calls back with null for invalid data', (done) => {
+      nativeImage.createFromBufferAsync(Buffer.from('not an image'), (image) => {
+        assert.equal(image, null)
+        done()
+      })
+    })
+  })
+
+  describe('resize(options)', () => {
+    it('keeps the aspect ratio when only the width is given', () => {
+      const imagePath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+      const image = nativeImage.createFromPath(imagePath).resize({width: 269})
+      assert.equal(image.getSize().width, 269)
+      assert.equal(image.getSize().height, 95)
+    })
+  })
 })
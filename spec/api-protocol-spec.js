@@ -532,6 +532,132 @@ describe('protocol module', function () {
       })
     })
 
+    it('can send POST request', function (done) {
+      var server = http.createServer(function (req, res) {
+        var body = ''
+        req.on('data', function (chunk) {
+          body += chunk
+        })
+        req.on('end', function () {
+          assert.equal(req.method, 'POST')
+          res.end(body)
+        })
+        server.close()
+      })
+      server.listen(0, '127.0.0.1', function () {
+        var port = server.address().port
+        var handler = function (request, callback) {
+          callback({
+            url: 'http://127.0.0.1:' + port,
+            method: 'POST',
+            uploadData: {
+              contentType: 'application/x-www-form-urlencoded',
+              data: request.uploadData[0].bytes.toString()
+            }
+          })
+        }
+        protocol.registerHttpProtocol(protocolName, handler, function (error) {
+          if (error) {
+            return done(error)
+          }
+          $.ajax({
+            url: protocolName + '://fake-host',
+            cache: false,
+            type: 'POST',
+            data: postData,
+            success: function (data) {
+              assert.deepEqual(qs.parse(data), postData)
+              done()
+            },
+            error: function (xhr, errorType, error) {
+              done(error)
+            }
+          })
+        })
+      })
+    })
+
+    it('keeps the cookies of the target URL', function (done) {
+      var server = http.createServer(function (req, res) {
+        if (req.url.startsWith('/set')) {
+          res.setHeader('Set-Cookie', 'fetch=cookie')
+          res.end('set')
+        } else {
+          res.end(req.headers.cookie || '')
+        }
+      })
+      server.listen(0, '127.0.0.1', function () {
+        var port = server.address().port
+        var handler = function (request, callback) {
+          callback({
+            url: 'http://127.0.0.1:' + port + request.url.substr((protocolName + '://fake-host').length)
+          })
+        }
+        var finish = function (error) {
+          server.close()
+          done(error)
+        }
+        protocol.registerHttpProtocol(protocolName, handler, function (error) {
+          if (error) {
+            return finish(error)
+          }
+          $.ajax({
+            url: protocolName + '://fake-host/set',
+            cache: false,
+            success: function () {
+              $.ajax({
+                url: protocolName + '://fake-host/get',
+                cache: false,
+                success: function (data) {
+                  assert.equal(data, 'fetch=cookie')
+                  finish()
+                },
+                error: function (xhr, errorType, error) {
+                  finish(error)
+                }
+              })
+            },
+            error: function (xhr, errorType, error) {
+              finish(error)
+            }
+          })
+        })
+      })
+    })
+
+    it('can send large responses', function (done) {
+      var body = 'x'.repeat(4 * 1024 * 1024)
+      var server = http.createServer(function (req, res) {
+        res.end(body)
+        server.close()
+      })
+      server.listen(0, '127.0.0.1', function () {
+        var port = server.address().port
+        var handler = function (request, callback) {
+          callback({
+            url: 'http://127.0.0.1:' + port
+          })
+        }
+        protocol.registerHttpProtocol(protocolName, handler, function (error) {
+          if (error) {
+            return done(error)
+          }
+          $.ajax({
+            url: protocolName + '://fake-host',
+            cache: false,
+            success: function (data) {
+              assert.equal(data.length, body.length)
+              assert.equal(data, body)
+              done()
+            },
+            error: function (xhr, errorType, error) {
+              done(error)
+            }
+          })
+        })
+      })
+    })
+
     it('works when target URL redirects', function (done) {
       var contents = null
       var server = http.createServer(function (req, res) {
@@ -569,6 +695,94 @@ describe('protocol module', function () {
     })
   })
 
+  describe('protocol.registerStreamProtocol', function () {
+    const {PassThrough} = remote.require('stream')
+
+    it('sends the stream data as response', function (done) {
+      var handler = function (request, callback) {
+        var stream = new PassThrough()
+        callback({
+          statusCode: 200,
+          headers: {'x-stream': 'yes'},
+          mimeType: 'text/plain',
+          data: stream
+        })
+        stream.write(text.substr(0, 5))
+        stream.end(text.substr(5))
+      }
+      protocol.registerStreamProtocol(protocolName, handler, function (error) {
+        if (error) {
+          return done(error)
+        }
+        $.ajax({
+          url: protocolName + '://fake-host',
+          cache: false,
+          success: function (data, status, request) {
+            assert.equal(data, text)
+            assert.equal(request.getResponseHeader('x-stream'), 'yes')
+            done()
+          },
+          error: function (xhr, errorType, error) {
+            done(error)
+          }
+        })
+      })
+    })
+
+    it('sends the data of a stream with an encoding', function (done) {
+      var encodedText = text + ' \u2713'
+      var handler = function (request, callback) {
+        var stream = new PassThrough()
+        stream.setEncoding('utf8')
+        callback({
+          statusCode: 200,
+          mimeType: 'text/plain',
+          data: stream
+        })
+        stream.write(encodedText.substr(0, 5))
+        stream.end(encodedText.substr(5))
+      }
+      protocol.registerStreamProtocol(protocolName, handler, function (error) {
+        if (error) {
+          return done(error)
+        }
+        $.ajax({
+          url: protocolName + '://fake-host',
+          cache: false,
+          success: function (data) {
+            assert.equal(data, encodedText)
+            done()
+          },
+          error: function (xhr, errorType, error) {
+            done(error)
+          }
+        })
+      })
+    })
+
+    it('fails when sending an object other than a stream', function (done) {
+      var handler = function (request, callback) {
+        callback({data: 'not a stream'})
+      }
+      protocol.registerStreamProtocol(protocolName, handler, function (error) {
+        if (error) {
+          return done(error)
+        }
+        $.ajax({
+          url: protocolName + '://fake-host',
+          cache: false,
+          success: function () {
+            done('request succeeded but it should not')
+          },
+          error: function (xhr, errorType) {
+            assert.equal(errorType, 'error')
+            done()
+          }
+        })
+      })
+    })
+  })
+
   describe('protocol.isProtocolHandled', function () {
     it('returns true for file:', function (done) {
       protocol.isProtocolHandled('file', function (result) {
@@ -402,4 +402,260 @@ describe('session module', function () {
       })
     })
   })
+
+  describe('ses.dumpNetLog(path, callback)', function () {
+    const dumpPath = path.join(remote.app.getPath('temp'), 'muon-net-log.json')
+
+    afterEach(function () {
+      session.defaultSession.setNetLogFilter([])
+      if (fs.existsSync(dumpPath)) fs.unlinkSync(dumpPath)
+    })
+
+    it('writes the buffered events', function (done) {
+      session.defaultSession.dumpNetLog(dumpPath, function (success) {
+        assert.equal(success, true)
+        const log = JSON.parse(fs.readFileSync(dumpPath))
+        assert.equal(typeof log.constants, 'object')
+        assert(Array.isArray(log.events))
+        assert(session.defaultSession.getNetLogStats().capacity > 0)
+        done()
+      })
+    })
+
+    it('rejects unknown event types', function () {
+      assert.throws(function () {
+        session.defaultSession.setNetLogFilter(['NOT_AN_EVENT'])
+      }, /Unknown net log event type/)
+    })
+  })
+
+  describe('ses.spellChecker', function () {
+    let spellChecker
+
+    beforeEach(function () {
+      spellChecker = session.fromPartition('spellchecker-spec').spellChecker
+      spellChecker.setWords([])
+    })
+
+    afterEach(function () {
+      spellChecker.setWords([])
+    })
+
+    it('adds and removes words in one change', function (done) {
+      spellChecker.addWords(['muonfoo', 'muonbar', 'muonbaz'])
+      spellChecker.getWords(function (words) {
+        assert.deepEqual(words, ['muonbar', 'muonbaz', 'muonfoo'])
+        spellChecker.removeWords(['muonbar', 'muonbaz'])
+        spellChecker.getWords(function (words) {
+          assert.deepEqual(words, ['muonfoo'])
+          done()
+        })
+      })
+    })
+
+    it('replaces the dictionary with setWords', function (done) {
+      spellChecker.addWords(['muonfoo', 'muonbar'])
+      spellChecker.setWords(['muonbar', 'muonqux'])
+      spellChecker.getWords(function (words) {
+        assert.deepEqual(words, ['muonbar', 'muonqux'])
+        done()
+      })
+    })
+
+    it('skips empty and invalid words', function (done) {
+      spellChecker.addWords(['', ' muonpadded ', 'muonfoo'])
+      spellChecker.removeWords([''])
+      spellChecker.getWords(function (words) {
+        assert.deepEqual(words, ['muonfoo'])
+        done()
+      })
+    })
+
+    it('applies changes made before the dictionary is loaded', function (done) {
+      const fresh = session.fromPartition('spellchecker-spec-fresh').spellChecker
+      fresh.setWords(['muonearly'])
+      fresh.getWords(function (words) {
+        assert.deepEqual(words, ['muonearly'])
+        fresh.setWords([])
+        fresh.getWords(function (words) {
+          assert.deepEqual(words, [])
+          done()
+        })
+      })
+    })
+  })
+
+  describe('ses.getCacheStats(callback)', function () {
+    const partitionName = 'persist:cache-stats-spec'
+    let server = null
+    let ses = null
+    let scriptRequests = 0
+
+    before(function (done) {
+      // The options only apply when the partition's session is created.
+      ses = session.fromPartition(partitionName, {
+        cache: true,
+        cacheType: 'simple',
+        cacheMaxSize: 1024 * 1024,
+        cacheMemoryOnly: true
+      })
+      server = http.createServer(function (req, res) {
+        if (req.url === '/cached.js') {
+          scriptRequests++
+          res.setHeader('Cache-Control', 'max-age=3600')
+          res.setHeader('Content-Type', 'application/javascript')
+          res.end('window.cached = true')
+        } else {
+          res.setHeader('Content-Type', 'text/html')
+          res.end('<script src="/cached.js"></script>')
+        }
+      })
+      server.listen(0, '127.0.0.1', done)
+    })
+
+    after(function () {
+      server.close()
+      server = null
+    })
+
+    beforeEach(function () {
+      if (w != null) w.destroy()
+      w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          partition: partitionName
+        }
+      })
+    })
+
+    it('counts the responses served from a memory-only cache', function (done) {
+      const pageUrl = `${url}:${server.address().port}/page`
+
+      w.webContents.once('did-finish-load', function () {
+        w.webContents.once('did-finish-load', function () {
+          assert.equal(scriptRequests, 1)
+          ses.getCacheStats(function (stats) {
+            assert(stats.hits >= 1)
+            assert(stats.misses >= 2)
+            assert(stats.bytesFromCache > 0)
+            assert(stats.bytesFromNetwork > 0)
+            done()
+          })
+        })
+        w.loadURL(`${pageUrl}?second`)
+      })
+      w.loadURL(`${pageUrl}?first`)
+    })
+  })
+
+  describe('ses.preconnect(url, options)', function () {
+    let server = null
+    let connections = 0
+
+    before(function (done) {
+      server = http.createServer(function (req, res) {
+        res.end('preconnected')
+      })
+      server.on('connection', function () {
+        connections++
+      })
+      server.listen(0, '127.0.0.1', done)
+    })
+
+    after(function () {
+      server.close()
+      server = null
+    })
+
+    it('rejects URLs that are not http or https', function () {
+      assert.throws(function () {
+        session.defaultSession.preconnect('file:///')
+      }, /Only http and https URLs can be preconnected/)
+    })
+
+    it('opens sockets that are used by the next request', function (done) {
+      const serverUrl = `${url}:${server.address().port}/`
+      session.defaultSession.getPreconnectStats(function (before) {
+        session.defaultSession.prefetchDNS(['localhost'])
+        session.defaultSession.preconnect(serverUrl, {numSockets: 2})
+
+        const waitForConnections = function () {
+          if (connections < 2) return setTimeout(waitForConnections, 10)
+          w.webContents.once('did-finish-load', function () {
+            assert.equal(connections, 2)
+            session.defaultSession.getPreconnectStats(function (stats) {
+              assert.equal(stats.socketsRequested - before.socketsRequested, 2)
+              assert(stats.socketsUsed - before.socketsUsed >= 1)
+              done()
+            })
+          })
+          w.loadURL(serverUrl)
+        }
+        waitForConnections()
+      })
+    })
+  })
+
+  describe('ses.autofill logins', function () {
+    const realm = 'https://autofill-spec.example/'
+    const createForm = function (username, password) {
+      return {
+        signon_realm: realm,
+        origin: `${realm}login`,
+        action: `${realm}submit`,
+        username: username,
+        username_element: 'user',
+        password: password,
+        password_element: 'pass'
+      }
+    }
+    const forms = [createForm('alice', 'one'), createForm('bob', 'two')]
+    let autofill
+
+    beforeEach(function () {
+      autofill = session.defaultSession.autofill
+    })
+
+    afterEach(function (done) {
+      autofill.removeLogins(forms, function () { done() })
+    })
+
+    it('adds a batch of logins and reads them a page at a time', function (done) {
+      autofill.addLogins(forms, function () {
+        autofill.getLogins({origin: realm}, function (logins, total) {
+          assert.equal(total, 2)
+          assert.deepEqual(logins.map((login) => login.username).sort(), ['alice', 'bob'])
+          autofill.getLogins({origin: realm, offset: 1, limit: 1}, function (logins, total) {
+            assert.equal(total, 2)
+            assert.equal(logins.length, 1)
+            done()
+          })
+        })
+      })
+    })
+
+    it('updates and removes a batch of logins', function (done) {
+      autofill.addLogins(forms, function () {
+        autofill.updateLogins([createForm('alice', 'three')], function () {
+          autofill.getLogins({origin: realm}, function (logins) {
+            const alice = logins.find((login) => login.username === 'alice')
+            assert.equal(alice.password, 'three')
+            autofill.removeLogins(forms, function () {
+              autofill.getLogins({origin: realm}, function (logins, total) {
+                assert.equal(total, 0)
+                assert.equal(logins.length, 0)
+                done()
+              })
+            })
+          })
+        })
+      })
+    })
+
+    it('requires options and a callback for getLogins', function () {
+      assert.throws(function () {
+        autofill.getLogins({})
+      }, /`options` and `callback` are required fields/)
+    })
+  })
 })
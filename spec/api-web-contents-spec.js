@@ -5,7 +5,7 @@ const path = require('path')
 const {closeWindow} = require('./window-helpers')
 
 const {remote} = require('electron')
-const {BrowserWindow, webContents} = remote
+const {BrowserWindow, session, webContents} = remote
 
 const isCi = remote.getGlobal('isCi')
 
@@ -97,4 +97,79 @@ describe('webContents module', function () {
       })
     })
   })
+
+  describe('registerScript() API', function () {
+    const code = `window.registeredAt = ${Date.now()}`
+
+    it('returns the same handle for the same code and extension', function () {
+      let handle = webContents.registerScript('extension-a', code)
+      assert.equal(typeof handle, 'number')
+      assert.equal(webContents.registerScript('extension-a', code), handle)
+      assert.notEqual(webContents.registerScript('extension-b', code), handle)
+      assert.notEqual(webContents.registerScript('extension-a', `${code} + 1`), handle)
+      webContents.unregisterScript(handle)
+      webContents.unregisterScript(handle)
+    })
+
+    it('keeps the script until every registration is released', function () {
+      let handle = webContents.registerScript('extension-c', code)
+      webContents.registerScript('extension-c', code)
+      webContents.unregisterScript(handle)
+      assert.equal(webContents.registerScript('extension-c', code), handle)
+      webContents.unregisterScript(handle)
+      webContents.unregisterScript(handle)
+      assert.notEqual(webContents.registerScript('extension-c', code), handle)
+    })
+
+    it('ignores unknown handles', function () {
+      assert.doesNotThrow(function () {
+        webContents.unregisterScript(-1)
+        webContents.unregisterScript(0x7fffffff)
+      })
+    })
+
+    describe('with a loaded extension', function () {
+      const extensionPath = path.join(fixtures, 'extensions', 'registered-script')
+      let extensionId = null
+
+      before(function (done) {
+        remote.process.once('extension-ready', function (installInfo) {
+          extensionId = installInfo.id
+          done()
+        })
+        session.defaultSession.extensions.load(extensionPath, {}, 'unpacked')
+      })
+
+      after(function () {
+        session.defaultSession.extensions.disable(extensionId)
+      })
+
+      it('runs the script by handle in a tab', function (done) {
+        const handle = webContents.registerScript(extensionId, '1 + 2')
+        w.webContents.once('did-finish-load', function () {
+          const started = w.webContents.executeRegisteredScript(handle, {}, function (error, url, results) {
+            webContents.unregisterScript(handle)
+            assert.ok(!error, error)
+            assert.deepEqual(results, [3])
+            done()
+          })
+          assert.equal(started, true)
+        })
+        w.loadURL('file://' + path.join(fixtures, 'pages', 'a.html'))
+      })
+
+      it('drops the scripts of an extension when it is disabled', function (done) {
+        const handle = webContents.registerScript(extensionId, '1 + 2')
+        remote.process.once('extension-unloaded', function (id) {
+          assert.equal(id, extensionId)
+          assert.throws(function () {
+            w.webContents.executeRegisteredScript(handle)
+          }, /Unknown script handle/)
+          session.defaultSession.extensions.enable(extensionId)
+          done()
+        })
+        session.defaultSession.extensions.disable(extensionId)
+      })
+    })
+  })
 })
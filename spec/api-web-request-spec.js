@@ -6,8 +6,18 @@ const session = remote.session
 
 describe('webRequest module', function () {
   var ses = session.defaultSession
+  var largeBody = Buffer.alloc(256 * 1024, 'a')
+  var hangingResponses = []
   var server = http.createServer(function (req, res) {
-    if (req.url === '/serverRedirect') {
+    if (req.url === '/fetch/large') {
+      res.setHeader('Content-Length', largeBody.length)
+      res.end(largeBody)
+    } else if (req.url === '/fetch/partial') {
+      res.write(largeBody)
+      hangingResponses.push(res)
+    } else if (req.url.startsWith('/fetch/hang')) {
+      hangingResponses.push(res)
+    } else if (req.url === '/serverRedirect') {
       res.statusCode = 301
       res.setHeader('Location', 'http://' + req.rawHeaders[1])
       res.end()
@@ -457,4 +467,83 @@ describe('webRequest module', function () {
       })
     })
   })
+
+  describe('webRequest.fetch', function () {
+    afterEach(function () {
+      ses.webRequest.setFetchConcurrency(6)
+      hangingResponses.forEach(function (res) { res.end() })
+      hangingResponses = []
+    })
+
+    // Calls |callback| once the server holds |count| hanging requests.
+    var waitForHangingRequests = function (count, callback) {
+      if (hangingResponses.length >= count) return callback()
+      setTimeout(waitForHangingRequests, 10, count, callback)
+    }
+
+    it('streams the body with onData and reports progress', function (done) {
+      var received = 0
+      var lastProgress = null
+      ses.webRequest.fetch(defaultURL + 'fetch/large', {
+        onData: function (chunk) {
+          assert(Buffer.isBuffer(chunk))
+          received += chunk.length
+        },
+        onProgress: function (current, total) {
+          lastProgress = [current, total]
+        }
+      }, function (error, response, body) {
+        assert.equal(error, null)
+        assert.equal(response.statusCode, 200)
+        assert.equal(body.length, 0)
+        assert.equal(received, largeBody.length)
+        assert.deepEqual(lastProgress, [largeBody.length, largeBody.length])
+        done()
+      })
+    })
+
+    it('can cancel a fetch from onData', function (done) {
+      var chunks = 0
+      var id = ses.webRequest.fetch(defaultURL + 'fetch/partial', {
+        onData: function () {
+          if (++chunks === 1) ses.webRequest.cancelFetch(id)
+        }
+      }, function (error) {
+        assert.equal(error.errorCode, -3)
+        done()
+      })
+    })
+
+    it('can cancel a running fetch', function (done) {
+      var id = ses.webRequest.fetch(defaultURL + 'fetch/hang', function (error) {
+        assert.equal(error.errorCode, -3)
+        done()
+      })
+      assert.equal(typeof id, 'number')
+      waitForHangingRequests(1, function () {
+        ses.webRequest.cancelFetch(id)
+      })
+    })
+
+    it('runs at most setFetchConcurrency fetches at once', function (done) {
+      ses.webRequest.setFetchConcurrency(1)
+      var finished = 0
+      var callback = function (error) {
+        assert.equal(error, null)
+        if (++finished === 2) done()
+      }
+      ses.webRequest.fetch(defaultURL + 'fetch/hang?first', callback)
+      ses.webRequest.fetch(defaultURL + 'fetch/hang?second', callback)
+
+      waitForHangingRequests(1, function () {
+        setTimeout(function () {
+          assert.equal(hangingResponses.length, 1)
+          hangingResponses.shift().end()
+          waitForHangingRequests(1, function () {
+            hangingResponses.shift().end()
+          })
+        }, 200)
+      })
+    })
+  })
 })
@@ -0,0 +1,48 @@
+const fs = require('fs')
+const path = require('path')
+const {median, round} = require('./util')
+
+const archives = ['a.asar', 'logo.asar', 'video.asar', 'web.asar'].map(
+  (name) => path.join(__dirname, '..', 'fixtures', 'asar', name))
+
+const listFiles = function (dir) {
+  let files = []
+  for (const name of fs.readdirSync(dir)) {
+    const file = path.join(dir, name)
+    const stats = fs.lstatSync(file)
+    if (stats.isDirectory()) {
+      files = files.concat(listFiles(file))
+    } else if (stats.isFile()) {
+      files.push(file)
+    }
+  }
+  return files
+}
+
+// Reads every file of the archives through the patched fs module, which is
+// how apps load their code from app.asar.
+const measure = function (files) {
+  const start = process.hrtime()
+  let bytes = 0
+  for (let i = 0; i < 20; i++) {
+    for (const file of files) {
+      fs.statSync(file)
+      bytes += fs.readFileSync(file).length
+    }
+  }
+  const elapsed = process.hrtime(start)
+  return {bytes, ms: elapsed[0] * 1e3 + elapsed[1] / 1e6, reads: files.length * 20}
+}
+
+module.exports = function (options) {
+  const files = archives.reduce((all, archive) => all.concat(listFiles(archive)), [])
+  const samples = []
+  for (let i = 0; i < options.runs; i++) {
+    samples.push(measure(files))
+  }
+  const ms = median(samples.map((sample) => sample.ms))
+  return Promise.resolve({
+    readsPerSecond: round(samples[0].reads / ms * 1000),
+    megabytesPerSecond: round(samples[0].bytes / (1024 * 1024) / ms * 1000)
+  })
+}
@@ -0,0 +1,8 @@
+const {app} = require('electron')
+
+const start = Number(process.env.BENCHMARK_START)
+
+app.on('ready', function () {
+  process.stdout.write(JSON.stringify({ready: Date.now() - start}) + '\n')
+  app.quit()
+})
@@ -0,0 +1,58 @@
+const {ipcMain} = require('electron')
+const {median, openFixture, round, waitForMessage} = require('./util')
+
+const count = 2000
+const payload = {
+  id: 42,
+  name: 'benchmark',
+  values: Array.from({length: 64}, (_, i) => i),
+  nested: {enabled: true, text: 'x'.repeat(256)}
+}
+
+// Times |count| async messages from the renderer to the browser, then |count|
+// sync round trips.
+const measure = function (w) {
+  return new Promise(function (resolve) {
+    let received = 0
+    let start
+    const onPing = function (event) {
+      if (event.sender !== w.webContents) return
+      if (received === 0) start = process.hrtime()
+      if (++received === count) {
+        const elapsed = process.hrtime(start)
+        ipcMain.removeListener('ping', onPing)
+        resolve(elapsed[0] * 1e3 + elapsed[1] / 1e6)
+      }
+    }
+    ipcMain.on('ping', onPing)
+    w.webContents.send('start', count, payload)
+  }).then(function (asyncMs) {
+    return waitForMessage(w.webContents, 'sync-done')
+      .then(([syncMs]) => ({asyncMs, syncMs}))
+  })
+}
+
+module.exports = function (options) {
+  const onPingSync = function (event) {
+    event.returnValue = null
+  }
+  ipcMain.on('ping-sync', onPingSync)
+
+  return openFixture('ipc.html').then(function (w) {
+    const samples = []
+    let run = Promise.resolve()
+    for (let i = 0; i < options.runs; i++) {
+      run = run.then(() => measure(w)).then((sample) => samples.push(sample))
+    }
+    return run.then(function () {
+      ipcMain.removeListener('ping-sync', onPingSync)
+      w.destroy()
+      const asyncMs = median(samples.map((sample) => sample.asyncMs))
+      const syncMs = median(samples.map((sample) => sample.syncMs))
+      return {
+        asyncMessagesPerSecond: round(count / asyncMs * 1000),
+        syncRoundTripMs: round(syncMs / count)
+      }
+    })
+  })
+}
@@ -0,0 +1,57 @@
+// Runs the benchmarks in order and prints their results as JSON, so runs can
+// be compared to catch regressions:
+//
+//   electron spec/benchmarks [--runs=5] [--grep=ipc] [--output=results.json]
+const {app} = require('electron')
+const fs = require('fs')
+
+const argv = require('yargs')
+  .number('runs').default('runs', 5)
+  .string('g').alias('g', 'grep')
+  .string('output')
+  .argv
+
+const benchmarks = {
+  startup: require('./startup'),
+  ipc: require('./ipc'),
+  remote: require('./remote'),
+  asar: require('./asar'),
+  tabs: require('./tabs'),
+  webRequest: require('./web-request')
+}
+
+app.on('window-all-closed', function () {})
+
+app.on('ready', function () {
+  const report = {
+    version: process.versions.electron,
+    chrome: process.versions.chrome,
+    platform: process.platform,
+    arch: process.arch,
+    runs: argv.runs,
+    results: {}
+  }
+
+  let failed = false
+  let run = Promise.resolve()
+  Object.keys(benchmarks).forEach(function (name) {
+    if (argv.grep && !name.includes(argv.grep)) return
+    run = run.then(() => benchmarks[name]({runs: argv.runs}))
+      .then(function (result) {
+        report.results[name] = result
+      }, function (error) {
+        failed = true
+        report.results[name] = {error: error.message}
+      })
+  })
+
+  run.then(function () {
+    const output = JSON.stringify(report, null, 2) + '\n'
+    if (argv.output) {
+      fs.writeFileSync(argv.output, output)
+    } else {
+      process.stdout.write(output)
+    }
+    app.exit(failed ? 1 : 0)
+  })
+})
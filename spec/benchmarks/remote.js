@@ -0,0 +1,32 @@
+const path = require('path')
+const {median, openFixture, round, waitForMessage} = require('./util')
+
+const count = 1000
+const modulePath = path.join(__dirname, '..', 'fixtures', 'module', 'many-members.js')
+
+// Times |count| remote calls returning an object whose prototype has 500
+// members, then |count| calls of a method of that prototype.
+const measure = function (w) {
+  const done = waitForMessage(w.webContents, 'remote-done')
+  w.webContents.send('start', count, modulePath)
+  return done.then(([createMs, callMs]) => ({createMs, callMs}))
+}
+
+module.exports = function (options) {
+  return openFixture('remote.html').then(function (w) {
+    const samples = []
+    let run = Promise.resolve()
+    for (let i = 0; i < options.runs; i++) {
+      run = run.then(() => measure(w)).then((sample) => samples.push(sample))
+    }
+    return run.then(function () {
+      w.destroy()
+      const createMs = median(samples.map((sample) => sample.createMs))
+      const callMs = median(samples.map((sample) => sample.callMs))
+      return {
+        manyMembersRoundTripMs: round(createMs / count),
+        manyMembersMethodCallMs: round(callMs / count)
+      }
+    })
+  })
+}
@@ -0,0 +1,38 @@
+const {spawn} = require('child_process')
+const path = require('path')
+const {median, round} = require('./util')
+
+const appPath = path.join(__dirname, 'fixtures', 'startup')
+
+// Launches a minimal app that quits once it is ready.
+const launch = function () {
+  return new Promise(function (resolve, reject) {
+    const start = Date.now()
+    const child = spawn(process.execPath, [appPath], {
+      env: Object.assign({}, process.env, {BENCHMARK_START: start})
+    })
+    let output = ''
+    child.stdout.on('data', (data) => { output += data })
+    child.on('error', reject)
+    child.on('exit', function (code) {
+      const exit = Date.now() - start
+      try {
+        resolve({ready: JSON.parse(output.trim().split('\n').pop()).ready, exit})
+      } catch (error) {
+        reject(new Error(`Startup app exited with ${code}: ${output}`))
+      }
+    })
+  })
+}
+
+module.exports = function (options) {
+  const samples = []
+  let run = Promise.resolve()
+  for (let i = 0; i < options.runs; i++) {
+    run = run.then(launch).then((sample) => samples.push(sample))
+  }
+  return run.then(() => ({
+    readyMs: round(median(samples.map((sample) => sample.ready))),
+    exitMs: round(median(samples.map((sample) => sample.exit)))
+  }))
+}
@@ -0,0 +1,50 @@
+const path = require('path')
+const url = require('url')
+const {median, openFixture, round, waitForMessage} = require('./util')
+
+const count = 50
+const tabURL = url.format({
+  protocol: 'file',
+  slashes: true,
+  pathname: path.join(__dirname, '..', 'fixtures', 'pages', 'a.html')
+})
+
+// Restores |count| discarded tabs in the window and collects the guest setup
+// timings of each of them.
+const measure = function (w) {
+  const done = waitForMessage(w.webContents, 'tabs-done')
+  w.webContents.send('start', count, tabURL, w.id)
+  return done.then(([restoreMs, timings]) => ({restoreMs, timings}))
+}
+
+// Medians of the step of every tab that reached it, in ms from its creation.
+const medianStep = function (samples, step) {
+  const values = []
+  samples.forEach(function (sample) {
+    sample.timings.forEach(function (timings) {
+      if (timings && typeof timings[step] === 'number') values.push(timings[step])
+    })
+  })
+  return values.length ? round(median(values)) : null
+}
+
+module.exports = function (options) {
+  const samples = []
+  let run = Promise.resolve()
+  for (let i = 0; i < options.runs; i++) {
+    run = run.then(() => openFixture('tabs.html')).then(function (w) {
+      return measure(w).then(function (sample) {
+        w.destroy()
+        samples.push(sample)
+      })
+    })
+  }
+  return run.then(function () {
+    return {
+      restoreTabsMs: round(median(samples.map((sample) => sample.restoreMs))),
+      tabInitializedMs: medianStep(samples, 'initialized'),
+      tabWillAttachMs: medianStep(samples, 'willAttach'),
+      tabDidAttachMs: medianStep(samples, 'didAttach')
+    }
+  })
+}
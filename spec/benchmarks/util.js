@@ -0,0 +1,43 @@
+const {BrowserWindow, ipcMain} = require('electron')
+const path = require('path')
+const url = require('url')
+
+exports.median = function (values) {
+  const sorted = values.slice().sort((a, b) => a - b)
+  const middle = Math.floor(sorted.length / 2)
+  if (sorted.length % 2) return sorted[middle]
+  return (sorted[middle - 1] + sorted[middle]) / 2
+}
+
+exports.round = function (value) {
+  return Math.round(value * 1000) / 1000
+}
+
+// Resolves with the arguments of the next |channel| message sent by
+// |webContents|.
+exports.waitForMessage = function (webContents, channel) {
+  return new Promise(function (resolve) {
+    const listener = function (event, ...args) {
+      if (event.sender !== webContents) return
+      ipcMain.removeListener(channel, listener)
+      resolve(args)
+    }
+    ipcMain.on(channel, listener)
+  })
+}
+
+// Opens a hidden window on a page of fixtures/ and resolves once the page has
+// sent 'ready'.
+exports.openFixture = function (name, webPreferences) {
+  const w = new BrowserWindow({
+    show: false,
+    webPreferences: webPreferences || {}
+  })
+  const ready = exports.waitForMessage(w.webContents, 'ready')
+  w.loadURL(url.format({
+    protocol: 'file',
+    slashes: true,
+    pathname: path.join(__dirname, 'fixtures', name)
+  }))
+  return ready.then(() => w)
+}
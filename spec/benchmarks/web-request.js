@@ -0,0 +1,76 @@
+const {session} = require('electron')
+const http = require('http')
+const {median, openFixture, round, waitForMessage} = require('./util')
+
+const count = 200
+const partition = 'benchmark-web-request'
+
+// Fetches |url| |count| times in a row from a page of the partition.
+const fetchAll = function (url) {
+  return openFixture('fetch.html', {partition}).then(function (w) {
+    const done = Promise.race([
+      waitForMessage(w.webContents, 'done'),
+      waitForMessage(w.webContents, 'error').then(([message]) => {
+        throw new Error(message)
+      })
+    ])
+    w.webContents.send('start', url, count)
+    return done.then(function ([ms]) {
+      w.destroy()
+      return ms
+    }, function (error) {
+      w.destroy()
+      throw error
+    })
+  })
+}
+
+// Compares the time of requests without webRequest listeners and with the
+// listeners that hold requests back until they answer.
+module.exports = function (options) {
+  const server = http.createServer((req, res) => res.end('ok'))
+  const ses = session.fromPartition(partition)
+  const listen = new Promise(function (resolve) {
+    server.listen(0, '127.0.0.1', function () {
+      resolve(`http://127.0.0.1:${server.address().port}/`)
+    })
+  })
+
+  const setListeners = function (enabled) {
+    const listener = enabled ? (details, callback) => callback({}) : null
+    ses.webRequest.onBeforeRequest(listener)
+    ses.webRequest.onBeforeSendHeaders(listener)
+    ses.webRequest.onHeadersReceived(listener)
+  }
+
+  return listen.then(function (url) {
+    const plain = []
+    const observed = []
+    let run = Promise.resolve()
+    for (let i = 0; i < options.runs; i++) {
+      run = run.then(() => setListeners(false))
+        .then(() => fetchAll(url))
+        .then((ms) => plain.push(ms))
+        .then(() => setListeners(true))
+        .then(() => fetchAll(url))
+        .then((ms) => observed.push(ms))
+    }
+    const finish = function () {
+      setListeners(false)
+      server.close()
+    }
+    return run.then(function () {
+      finish()
+      const plainMs = median(plain) / count
+      const observedMs = median(observed) / count
+      return {
+        requestMs: round(plainMs),
+        requestWithListenersMs: round(observedMs),
+        overheadMs: round(observedMs - plainMs)
+      }
+    }, function (error) {
+      finish()
+      throw error
+    })
+  })
+}
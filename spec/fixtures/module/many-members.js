@@ -0,0 +1,22 @@
+'use strict'
+
+class ManyMembers {
+  getCount () {
+    return this.count
+  }
+}
+
+for (let i = 0; i < 500; i++) {
+  ManyMembers.prototype[`method${i}`] = function () { return i }
+}
+
+exports.create = function () {
+  let object = new ManyMembers()
+  object.count = 500
+  return object
+}
+
+// Adds one more member to the shared prototype.
+exports.addMethod = function () {
+  ManyMembers.prototype.method500 = function () { return 500 }
+}
@@ -886,6 +886,204 @@ describe('<webview> tag', function () {
     })
   })
 
+  describe('destroyed event', function () {
+    it('is dispatched when the guest is destroyed', function (done) {
+      webview.addEventListener('did-finish-load', function () {
+        webview.addEventListener('destroyed', function () {
+          done()
+        })
+        webview.getWebContents().forceClose()
+      })
+      webview.src = 'about:blank'
+      document.body.appendChild(webview)
+    })
+  })
+
+  describe('<webview>.getWebContents().getGuestTimings()', function () {
+    it('returns the setup timings of the guest', function (done) {
+      webview.addEventListener('did-finish-load', function () {
+        const timings = webview.getWebContents().getGuestTimings()
+        assert.equal(typeof timings.initialized, 'number')
+        assert.equal(typeof timings.willAttach, 'number')
+        assert.equal(typeof timings.didAttach, 'number')
+        assert(timings.initialized >= 0)
+        assert(timings.willAttach >= timings.initialized)
+        assert(timings.didAttach >= timings.willAttach)
+        done()
+      })
+      webview.src = 'about:blank'
+      document.body.appendChild(webview)
+    })
+
+    it('returns null for web contents that are not guests', function () {
+      const {remote} = require('electron')
+      assert.equal(remote.getCurrentWebContents().getGuestTimings(), null)
+    })
+  })
+
+  describe('app.setTabDiscardPolicy(options)', function () {
+    const {remote} = require('electron')
+    const {webContents} = remote
+    let tabIds = []
+    let views = []
+
+    afterEach(function () {
+      app.setTabDiscardPolicy({memoryBudget: 0})
+      tabIds.forEach(function (tabId) {
+        const tab = webContents.fromTabID(tabId)
+        if (tab) tab.close()
+      })
+      tabIds = []
+      views.forEach(function (view) {
+        if (document.body.contains(view)) document.body.removeChild(view)
+      })
+      views = []
+    })
+
+    // Opens a background tab in this window and calls |callback| once it has
+    // loaded.
+    const createLoadedTab = function (callback) {
+      webContents.createTab(remote.getCurrentWebContents(), session.defaultSession, {
+        url: 'file://' + fixtures + '/pages/a.html',
+        active: false,
+        windowId: remote.getCurrentWindow().id
+      }, function (tab) {
+        tabIds.push(tab.getId())
+        const view = new WebView()
+        views.push(view)
+        let loaded = false
+        view.addEventListener('did-finish-load', function () {
+          if (loaded) return
+          loaded = true
+          callback()
+        })
+        document.body.appendChild(view)
+        view.attachGuest(tab.guestInstanceId)
+      })
+    }
+
+    it('discards nothing while the policy is disabled', function (done) {
+      createLoadedTab(function () {
+        app.setTabDiscardPolicy({memoryBudget: 0})
+        assert.equal(app.discardTabs(), 0)
+        done()
+      })
+    })
+
+    it('discards background tabs over the budget and restores them', function (done) {
+      const discarded = []
+      let count = -1
+
+      // Activates a discarded tab once every discard has been reported.
+      const maybeRestore = function () {
+        if (discarded.length !== count) return
+        app.removeListener('tab-discarded', onDiscarded)
+        const tabId = discarded[0]
+        app.once('tab-restored', function (event, restoredId, details) {
+          assert.equal(restoredId, tabId)
+          assert(details.bytesFreed >= 0)
+          done()
+        })
+        webContents.fromTabID(tabId).setActive(true)
+      }
+
+      const onDiscarded = function (event, tabId, details) {
+        assert.equal(typeof tabId, 'number')
+        assert.notEqual(tabIds.indexOf(details.oldTabId), -1)
+        assert(details.bytesFreed >= 0)
+        tabIds.push(tabId)
+        discarded.push(tabId)
+        maybeRestore()
+      }
+
+      // The first tab of the window is selected, so open one more than the
+      // tabs that can be discarded.
+      createLoadedTab(function () {
+        createLoadedTab(function () {
+          createLoadedTab(function () {
+            app.on('tab-discarded', onDiscarded)
+            app.setTabDiscardPolicy({
+              memoryBudget: 1,
+              minInactiveTime: 0,
+              protectPinned: false,
+              protectAudible: false,
+              protectFormInput: false
+            })
+            count = app.discardTabs()
+            assert(count > 0)
+            maybeRestore()
+          })
+        })
+      })
+    })
+  })
+
+  describe('app.setMaxConcurrentTabLoads(count)', function () {
+    const {webContents} = require('electron').remote
+    let server = null
+    let pendingResponses = []
+    let views = []
+
+    before(function (done) {
+      server = http.createServer(function (req, res) {
+        pendingResponses.push(res)
+      })
+      server.listen(0, '127.0.0.1', done)
+    })
+
+    after(function () {
+      server.close()
+      server = null
+    })
+
+    afterEach(function () {
+      app.setMaxConcurrentTabLoads(3)
+      pendingResponses.forEach(function (res) { res.end() })
+      pendingResponses = []
+      views.forEach(function (view) {
+        if (document.body.contains(view)) document.body.removeChild(view)
+      })
+      views = []
+    })
+
+    // Calls |callback| once the server holds |count| requests.
+    const waitForRequests = function (count, callback) {
+      if (pendingResponses.length >= count) return callback()
+      setTimeout(waitForRequests, 10, count, callback)
+    }
+
+    const createPrewarmedTab = function (path) {
+      const {remote} = require('electron')
+      webContents.createTab(remote.getCurrentWebContents(), session.defaultSession, {
+        url: `http://127.0.0.1:${server.address().port}${path}`,
+        active: false,
+        discarded: true,
+        prewarm: true
+      }, function (tab) {
+        const view = new WebView()
+        views.push(view)
+        document.body.appendChild(view)
+        view.attachGuest(tab.guestInstanceId)
+      })
+    }
+
+    it('loads prewarmed tabs one after another', function (done) {
+      app.setMaxConcurrentTabLoads(1)
+      createPrewarmedTab('/first')
+      createPrewarmedTab('/second')
+
+      waitForRequests(1, function () {
+        setTimeout(function () {
+          assert.equal(pendingResponses.length, 1)
+          pendingResponses.shift().end('first')
+          waitForRequests(1, function () {
+            done()
+          })
+        }, 500)
+      })
+    })
+  })
+
   describe('did-get-response-details event', function () {
     it('emits for the page and its resources', function (done) {
       // expected {fileName: resourceType} pairs